@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <optional>
+#include <functional>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
@@ -20,4 +22,27 @@ struct AlgorithmDTO {
     bool operator==(const AlgorithmDTO& other) const {
         return algorithm_id == other.algorithm_id;
     }
-};
\ No newline at end of file
+
+    // отслеживание изменений: хэши полей на момент загрузки из БД
+    // (объект, который не загружался из БД, считается изменённым целиком)
+    void mark_clean() {
+        loaded_name_hash = std::hash<json>{}(name);
+        loaded_description_hash = std::hash<json>{}(description);
+    }
+
+    bool is_name_dirty() const {
+        return !loaded_name_hash.has_value() || loaded_name_hash.value() != std::hash<json>{}(name);
+    }
+
+    bool is_description_dirty() const {
+        return !loaded_description_hash.has_value() || loaded_description_hash.value() != std::hash<json>{}(description);
+    }
+
+    bool is_dirty() const {
+        return is_name_dirty() || is_description_dirty();
+    }
+
+private:
+    std::optional<size_t> loaded_name_hash;
+    std::optional<size_t> loaded_description_hash;
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <algorithm>
 #include "AlgorithmDTO.hpp"
 #include "RepresentationDTO.hpp"
 #include "RepresentationStringDTO.hpp"
@@ -12,7 +14,7 @@ struct AlgorithmRepresentation {
 
     AlgorithmRepresentation() {}
     AlgorithmRepresentation(AlgorithmDTO algorithm, RepresentationDTO representation, std::vector<RepresentationStringDTO> representation_strings) :
-        algorithm(algorithm), representation(representation), representation_strings(representation_strings) {}
+        algorithm(std::move(algorithm)), representation(std::move(representation)), representation_strings(std::move(representation_strings)) {}
 
     // AlgorithmRepresentation(int algorithm_id, std::string name, std::string description, int representationId, int dimensionality, int iterations, std::string content, std::string validity) :
 
@@ -23,4 +25,20 @@ struct AlgorithmRepresentation {
     bool operator==(const AlgorithmRepresentation& other) const {
         return representation.representation_id == other.representation.representation_id;
     }
+
+    // состояние после загрузки из БД или после записи в БД
+    void mark_clean() {
+        algorithm.mark_clean();
+        representation.mark_clean();
+        for (auto& representation_string : representation_strings) {
+            representation_string.mark_clean();
+        }
+    }
+
+    bool is_dirty() const {
+        return algorithm.is_dirty() || representation.is_dirty() ||
+            std::any_of(representation_strings.begin(), representation_strings.end(), [](const RepresentationStringDTO& representation_string) {
+                return representation_string.is_dirty();
+            });
+    }
 };
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// условия поиска представлений; все условия проверяются на стороне БД
+struct AlgorithmRepresentationFilter {
+    std::string name;                   // слова названия на языке сессии БД (в памяти — на языке language), должны входить все
+    std::string description;            // описание на языке language; пустое или "-" описание в БД подходит к любому
+    std::string language;
+    std::vector<int> dimensionality;
+    int iterations;
+
+    AlgorithmRepresentationFilter() : iterations(0) {}
+    AlgorithmRepresentationFilter(const std::string& name, const std::string& description, const std::string& language, const std::vector<int>& dimensionality, int iterations) :
+        name(name), description(description), language(language), dimensionality(dimensionality), iterations(iterations) {}
+};
\ No newline at end of file
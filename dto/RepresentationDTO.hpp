@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include <optional>
 
 struct RepresentationDTO {
     int representation_id;
@@ -21,4 +22,26 @@ struct RepresentationDTO {
     bool operator==(const RepresentationDTO& other) const {
         return representation_id == other.representation_id;
     }
-};
\ No newline at end of file
+
+    // отслеживание изменений: значения полей на момент загрузки из БД
+    void mark_clean() {
+        loaded_dimensionality = dimensionality;
+        loaded_iterations = iterations;
+    }
+
+    bool is_dimensionality_dirty() const {
+        return !loaded_dimensionality.has_value() || loaded_dimensionality.value() != dimensionality;
+    }
+
+    bool is_iterations_dirty() const {
+        return !loaded_iterations.has_value() || loaded_iterations.value() != iterations;
+    }
+
+    bool is_dirty() const {
+        return is_dimensionality_dirty() || is_iterations_dirty();
+    }
+
+private:
+    std::optional<std::vector<int>> loaded_dimensionality;
+    std::optional<int> loaded_iterations;
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <optional>
+#include <functional>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
@@ -12,8 +14,8 @@ struct RepresentationStringDTO {
     std::optional<json> validity;
 
     RepresentationStringDTO() {}
-    RepresentationStringDTO(long int id, int representation_id, const std::string& content, std::optional<json> validity) : 
-        representation_string_id(id), representation_id(representation_id), content(content), validity(validity) {}
+    RepresentationStringDTO(long int id, int representation_id, std::string content, std::optional<json> validity) : 
+        representation_string_id(id), representation_id(representation_id), content(std::move(content)), validity(std::move(validity)) {}
     
     bool operator<(const RepresentationStringDTO& other) const {
         return representation_string_id < other.representation_string_id;
@@ -22,4 +24,31 @@ struct RepresentationStringDTO {
     bool operator==(const RepresentationStringDTO& other) const {
         return representation_string_id == other.representation_string_id;
     }
-};
\ No newline at end of file
+
+    // отслеживание изменений: хэши полей на момент загрузки из БД
+    // (объект, который не загружался из БД, считается изменённым целиком)
+    void mark_clean() {
+        loaded_content_hash = std::hash<std::string>{}(content);
+        loaded_validity_hash = hash_validity();
+    }
+
+    bool is_content_dirty() const {
+        return !loaded_content_hash.has_value() || loaded_content_hash.value() != std::hash<std::string>{}(content);
+    }
+
+    bool is_validity_dirty() const {
+        return !loaded_validity_hash.has_value() || loaded_validity_hash.value() != hash_validity();
+    }
+
+    bool is_dirty() const {
+        return is_content_dirty() || is_validity_dirty();
+    }
+
+private:
+    std::optional<size_t> loaded_content_hash;
+    std::optional<size_t> loaded_validity_hash;
+
+    size_t hash_validity() const {
+        return validity.has_value() ? std::hash<json>{}(validity.value()) : 0;
+    }
+};
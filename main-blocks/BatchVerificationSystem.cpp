@@ -0,0 +1,198 @@
+#include "BatchVerificationSystem.hpp"
+
+BatchVerificationSystem::BatchVerificationSystem(ConnectionPool& connection_pool, size_t concurrency, SyntaxBlockWorkingMode working_mode)
+    : connection_pool(connection_pool), concurrency(concurrency), working_mode(working_mode), cache(nullptr), tiered(true), write_behind_depth(0), journal(nullptr), statistics(), checked_count(0) {}
+
+BatchVerificationSystem::~BatchVerificationSystem() {}
+
+void BatchVerificationSystem::set_cache(VerificationCache* cache)
+{
+    this->cache = cache;
+}
+
+void BatchVerificationSystem::set_tiered(bool tiered)
+{
+    this->tiered = tiered;
+}
+
+void BatchVerificationSystem::set_snapshot_cache_directory(const std::string& directory)
+{
+    this->snapshot_cache_directory = directory;
+}
+
+void BatchVerificationSystem::set_write_behind_depth(size_t depth)
+{
+    this->write_behind_depth = depth;
+}
+
+void BatchVerificationSystem::set_journal(ProgressJournal* journal)
+{
+    this->journal = journal;
+}
+
+VerificationStatistics BatchVerificationSystem::get_statistics() const
+{
+    return statistics;
+}
+
+size_t BatchVerificationSystem::get_checked_count() const
+{
+    return checked_count;
+}
+
+void BatchVerificationSystem::check_db_representations(const std::vector<int>& all_representation_ids)
+{
+    std::vector<int> representation_ids;
+    if (journal != nullptr) {
+        // по возрастанию, чтобы водяной знак журнала продвигался вслед за проверкой
+        std::vector<int> sorted_representation_ids = all_representation_ids;
+        std::sort(sorted_representation_ids.begin(), sorted_representation_ids.end());
+        journal->begin(sorted_representation_ids);
+        for (int representation_id : sorted_representation_ids) {
+            if (!journal->is_committed(representation_id)) {
+                representation_ids.push_back(representation_id);
+            }
+        }
+    }
+    else {
+        representation_ids = all_representation_ids;
+    }
+
+    // для отложенной записи нужно отдельное соединение, иначе пишет каждый поток проверки
+    std::optional<ConnectionPool::Lease> writer_connection;
+    std::unique_ptr<WriteBehindQueue> write_queue;
+    if (write_behind_depth > 0 && connection_pool.size() > 1) {
+        writer_connection.emplace(connection_pool.acquire());
+        write_queue = std::make_unique<WriteBehindQueue>(write_behind_depth);
+        write_queue->set_snapshot_cache_directory(snapshot_cache_directory);
+        write_queue->set_reconnect([&writer_connection]() {
+            writer_connection->reconnect();
+            return writer_connection->get();
+        }, max_attempts);
+        if (journal != nullptr) {
+            write_queue->set_written_callback([this](const std::vector<AlgorithmRepresentation>& written) {
+                for (const auto& object : written) {
+                    journal->commit(object.representation.representation_id);
+                }
+            });
+        }
+        write_queue->connect(writer_connection->get());
+    }
+
+    size_t available_connections = connection_pool.size() - (write_queue ? 1 : 0);
+    size_t workers_count = std::min({ std::max<size_t>(concurrency, 1), available_connections, representation_ids.size() });
+
+    std::atomic<size_t> next_index = 0;
+    std::atomic<bool> is_failed = false;
+    std::exception_ptr first_error;
+    std::mutex error_mutex;
+
+    auto worker = [&]() {
+        while (!is_failed) {
+            size_t index = next_index++;
+            if (index >= representation_ids.size()) {
+                break;
+            }
+            try {
+                for (size_t attempt = 1; ; attempt++) {
+                    try {
+                        check_db_representation(representation_ids[index], write_queue.get());
+                        break;
+                    }
+                    catch (const pqxx::broken_connection& e) {
+                        // разорванное соединение заменяется при следующем acquire()
+                        if (attempt >= max_attempts) {
+                            throw;
+                        }
+                        std::cerr << "BatchVerificationSystem: representation " << representation_ids[index]
+                            << ", connection lost, retrying: " << e.what() << std::endl;
+                    }
+                }
+            }
+            catch (...) {
+                // после первой ошибки новые представления не берутся, ошибка пробрасывается после join()
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!first_error) {
+                    first_error = std::current_exception();
+                }
+                is_failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(workers_count);
+    for (size_t i = 0; i < workers_count; i++) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    // очередь дописывается и при ошибке проверки, чтобы уже проверенные представления не потерялись
+    if (write_queue) {
+        try {
+            write_queue->disconnect();
+        }
+        catch (...) {
+            if (!first_error) {
+                first_error = std::current_exception();
+            }
+        }
+    }
+
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+    if (journal != nullptr) {
+        journal->finish();
+    }
+}
+
+void BatchVerificationSystem::check_db_representation(int representation_id, WriteBehindQueue* write_queue)
+{
+    auto connection = connection_pool.acquire();
+
+    AlgorithmRepository algorithm_repository;
+    RepresentationRepository representation_repository;
+    RepresentationStringRepository representation_string_repository;
+    algorithm_repository.connect(connection.get());
+    representation_repository.connect(connection.get());
+    representation_string_repository.connect(connection.get());
+
+    std::unique_ptr<IAlgorithmRepresentationRepository> repository = std::make_unique<AlgorithmRepresentationRepository>(
+        algorithm_repository, representation_repository, representation_string_repository);
+    if (!snapshot_cache_directory.empty()) {
+        repository = std::make_unique<SnapshotCacheRepository>(std::move(repository), snapshot_cache_directory);
+    }
+    repository->connect(connection.get());
+
+    auto representation = repository->get_by_id(representation_id);
+    if (!representation.has_value()) {
+        if (journal != nullptr) {
+            journal->commit(representation_id);
+        }
+        return;
+    }
+
+    VerificationSystem v_system = VerificationSystem(working_mode);
+    v_system.set_cache(cache);
+    v_system.set_tiered(tiered);
+    if (write_queue != nullptr) {
+        v_system.check_db_representation(representation.value(), *write_queue);
+    }
+    else {
+        v_system.check_db_representation(representation.value(), *repository);
+        if (journal != nullptr) {
+            journal->commit(representation_id);
+        }
+    }
+
+    VerificationStatistics representation_statistics = v_system.get_statistics();
+    std::lock_guard<std::mutex> lock(statistics_mutex);
+    statistics.strings_count += representation_statistics.strings_count;
+    statistics.unique_strings_count += representation_statistics.unique_strings_count;
+    statistics.cache_hits_count += representation_statistics.cache_hits_count;
+    statistics.diagnosed_strings_count += representation_statistics.diagnosed_strings_count;
+    checked_count++;
+}
\ No newline at end of file
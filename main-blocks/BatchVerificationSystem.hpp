@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <exception>
+#include "VerificationSystem.hpp"
+#include "./../repositories/ConnectionPool.hpp"
+#include "./../repositories/AlgorithmRepository.hpp"
+#include "./../repositories/RepresentationRepository.hpp"
+#include "./../repositories/RepresentationStringRepository.hpp"
+#include "./../repositories/AlgorithmRepresentationRepository.hpp"
+#include "./../repositories/SnapshotCacheRepository.hpp"
+#include "./../repositories/WriteBehindQueue.hpp"
+#include "./../utils/ProgressJournal.hpp"
+
+// проверка множества представлений из БД (режим DB с Batch)
+// каждый поток берёт соединение из пула, загружает представление, проверяет его и записывает результаты обратно;
+// разбор строк выполняется по очереди (см. VerificationSystem::events_mutex), загрузка и запись — параллельно;
+// с отложенной записью результаты пишет отдельный поток WriteBehindQueue на выделенном соединении пула.
+// после разрыва соединения представление проверяется и записывается повторно на новом соединении пула
+class BatchVerificationSystem {
+public:
+    BatchVerificationSystem(ConnectionPool& connection_pool, size_t concurrency, SyntaxBlockWorkingMode working_mode = SyntaxBlockWorkingMode::UntilFirstError);
+    ~BatchVerificationSystem();
+
+    void check_db_representations(const std::vector<int>& representation_ids);
+    void set_cache(VerificationCache* cache);
+    void set_tiered(bool tiered);
+    // каталог снимков представлений (SnapshotCacheRepository), пустая строка — без снимков
+    void set_snapshot_cache_directory(const std::string& directory);
+    // глубина очереди отложенной записи, 0 — запись в потоке проверки
+    void set_write_behind_depth(size_t depth);
+    // записанные представления отмечаются в журнале, уже отмеченные в нём пропускаются
+    void set_journal(ProgressJournal* journal);
+    VerificationStatistics get_statistics() const;
+    size_t get_checked_count() const;
+
+private:
+    ConnectionPool& connection_pool;
+    size_t concurrency;
+    SyntaxBlockWorkingMode working_mode;
+    VerificationCache* cache;
+    bool tiered;
+    std::string snapshot_cache_directory;
+    size_t write_behind_depth;
+    ProgressJournal* journal;
+
+    VerificationStatistics statistics;
+    size_t checked_count;
+    std::mutex statistics_mutex;
+
+    // попытки проверки одного представления при pqxx::broken_connection
+    static constexpr size_t max_attempts = 3;
+
+    void check_db_representation(int representation_id, WriteBehindQueue* write_queue);
+};
\ No newline at end of file
@@ -468,7 +468,7 @@ void LexicalBlock::process_symbol_depending_on_state(const SimpleToken& token, s
     }
 }
 
-std::vector<VariableToken> LexicalBlock::transliterate_string(const std::string& str)
+std::vector<VariableToken> LexicalBlock::transliterate_string(std::string_view str)
 {
     TransliterationBlock transliteration_block = TransliterationBlock();
     for (int i = 0; i < (int)str.size(); i++) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <variant>
 #include <optional>
@@ -23,7 +24,7 @@ class LexicalBlock {
 public:
     LexicalBlock();
     std::vector<VariableToken> transliterate_simple_token_vector(std::vector<VariableToken>& tokens);
-    std::vector<VariableToken> transliterate_string(const std::string& str);
+    std::vector<VariableToken> transliterate_string(std::string_view str);
 
 private:
     std::vector<VariableToken> combined_token_vector;      // итоговый список лексем
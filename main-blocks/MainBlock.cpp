@@ -16,7 +16,7 @@ MainBlock::MainBlock(SyntaxBlockWorkingMode working_mode)
 
 MainBlock::~MainBlock() {}
 
-bool MainBlock::check_string(const std::string& str)
+bool MainBlock::check_string(std::string_view str)
 {
     std::vector<std::variant<SimpleToken, ComplexToken>> combined_tokens = this->lexical_block.transliterate_string(str);
     this->syntax_block.load_token_vector(combined_tokens);
@@ -24,8 +24,14 @@ bool MainBlock::check_string(const std::string& str)
     return this->syntax_block.check_token_vector(combined_tokens, working_mode);
 }
 
-bool MainBlock::check_string(int string_index, const std::string& str)
+bool MainBlock::check_string(int string_index, std::string_view str)
 {
     this->syntax_block.set_string_index(string_index);
     return this->check_string(str);
+}
+
+bool MainBlock::accept_string(std::string_view str)
+{
+    std::vector<std::variant<SimpleToken, ComplexToken>> combined_tokens = this->lexical_block.transliterate_string(str);
+    return this->syntax_block.accept_token_vector(combined_tokens);
 }
\ No newline at end of file
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "TransliterationBlock.hpp"
 #include "LexicalBlock.hpp"
 #include "SyntaxBlock.hpp"
@@ -10,8 +12,9 @@ public:
     MainBlock(SyntaxBlockWorkingMode working_mode = SyntaxBlockWorkingMode::UntilFirstError);
     ~MainBlock();
 
-    bool check_string(const std::string& str);
-    bool check_string(int string_index, const std::string& str);
+    bool check_string(std::string_view str);
+    bool check_string(int string_index, std::string_view str);
+    bool accept_string(std::string_view str);
 
 private:
     SyntaxBlockWorkingMode working_mode;
@@ -0,0 +1,166 @@
+#include "NotificationWorker.hpp"
+
+#include <charconv>
+#include <stdexcept>
+
+NotificationWorker::NotificationWorker(SyntaxBlockWorkingMode working_mode)
+    : working_mode(working_mode),
+      cache(nullptr),
+      tiered(true),
+      batch_window(200),
+      idle_timeout(0),
+      connection(nullptr),
+      owns_connection(false),
+      is_stopping(false),
+      statistics(),
+      batches_count(0) {}
+
+NotificationWorker::~NotificationWorker()
+{
+    disconnect();
+}
+
+void NotificationWorker::connect(std::string connection)
+{
+    connect(new pqxx::connection(connection));
+    this->owns_connection = true;
+}
+
+void NotificationWorker::connect(pqxx::connection* connection)
+{
+    disconnect();
+    this->connection = connection;
+    this->owns_connection = false;
+    representation_string_repository.connect(connection);
+
+    this->connection->listen(channel, [this](pqxx::notification notification) {
+        long int representation_string_id;
+        auto [end, error] = std::from_chars(notification.payload.data(), notification.payload.data() + notification.payload.size(), representation_string_id);
+        if (error == std::errc()) {
+            pending_ids.insert(representation_string_id);
+        }
+    });
+}
+
+void NotificationWorker::disconnect()
+{
+    if (connection == nullptr) return;
+
+    // обработчик ссылается на this, а соединение может пережить обработчик
+    connection->listen(channel, pqxx::notification_handler{});
+    representation_string_repository.disconnect();
+    if (owns_connection) {
+        delete connection;
+    }
+    connection = nullptr;
+    owns_connection = false;
+}
+
+void NotificationWorker::set_cache(VerificationCache* cache)
+{
+    this->cache = cache;
+}
+
+void NotificationWorker::set_tiered(bool tiered)
+{
+    this->tiered = tiered;
+}
+
+void NotificationWorker::set_batch_window(std::chrono::milliseconds batch_window)
+{
+    this->batch_window = batch_window;
+}
+
+void NotificationWorker::set_idle_timeout(std::chrono::seconds idle_timeout)
+{
+    this->idle_timeout = idle_timeout;
+}
+
+VerificationStatistics NotificationWorker::get_statistics() const
+{
+    return statistics;
+}
+
+size_t NotificationWorker::get_batches_count() const
+{
+    return batches_count;
+}
+
+void NotificationWorker::stop()
+{
+    is_stopping = true;
+}
+
+void NotificationWorker::run()
+{
+    if (connection == nullptr) {
+        throw std::runtime_error("NotificationWorker::run() called before connect()");
+    }
+
+    using clock = std::chrono::steady_clock;
+    is_stopping = false;
+
+    // канал уже слушается (connect()), поэтому изменения после этого запроса придут уведомлениями
+    for (long int representation_string_id : representation_string_repository.get_ids_without_validity()) {
+        pending_ids.insert(representation_string_id);
+    }
+    auto idle_since = clock::now();
+
+    while (!is_stopping) {
+        if (pending_ids.empty()) {
+            await_notifications(poll_interval);
+            if (pending_ids.empty()) {
+                if (idle_timeout.count() > 0 && clock::now() - idle_since >= idle_timeout) {
+                    break;
+                }
+                continue;
+            }
+        }
+
+        // первое уведомление получено, ждём остальные изменения той же правки
+        auto deadline = clock::now() + batch_window;
+        while (!is_stopping && pending_ids.size() < max_batch_size) {
+            auto now = clock::now();
+            if (now >= deadline) {
+                break;
+            }
+            await_notifications(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now));
+        }
+
+        // после прохода при запуске строк может быть больше, чем в одной пачке
+        std::set<long int> representation_string_ids;
+        while (!pending_ids.empty() && representation_string_ids.size() < max_batch_size) {
+            representation_string_ids.insert(pending_ids.extract(pending_ids.begin()));
+        }
+        check_strings(representation_string_ids);
+        idle_since = clock::now();
+    }
+}
+
+void NotificationWorker::await_notifications(std::chrono::milliseconds timeout)
+{
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(timeout - seconds);
+    connection->await_notification(seconds.count(), microseconds.count());
+}
+
+// строки загружаются после окна, поэтому проверяется последнее содержимое;
+// если content изменится во время проверки, новое уведомление придёт в следующую пачку и перезапишет validity
+void NotificationWorker::check_strings(const std::set<long int>& representation_string_ids)
+{
+    auto representation_strings = representation_string_repository.get_by_ids(
+        std::vector<long int>(representation_string_ids.begin(), representation_string_ids.end()));
+    if (representation_strings.empty()) return;
+
+    VerificationSystem v_system = VerificationSystem(working_mode);
+    v_system.set_cache(cache);
+    v_system.set_tiered(tiered);
+    v_system.check_db_strings(representation_strings, representation_string_repository);
+
+    VerificationStatistics batch_statistics = v_system.get_statistics();
+    statistics.strings_count += batch_statistics.strings_count;
+    statistics.unique_strings_count += batch_statistics.unique_strings_count;
+    statistics.cache_hits_count += batch_statistics.cache_hits_count;
+    statistics.diagnosed_strings_count += batch_statistics.diagnosed_strings_count;
+    batches_count++;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <set>
+#include <atomic>
+#include <chrono>
+#include <pqxx/pqxx>
+#include "VerificationSystem.hpp"
+#include "./../repositories/RepresentationStringRepository.hpp"
+
+// фоновая проверка изменённых строк (режим DB с Listen)
+// слушает канал, который заполняет триггер sql/migrations/002_representation_strings_notify.sql,
+// копит идентификаторы строк в течение окна и проверяет только их, записывая validity одним update_many().
+// уведомления не хранятся, пока обработчик не слушает канал, поэтому при запуске run() сначала проверяет строки без validity:
+// триггер миграции сбрасывает validity при изменении content, так что правки, сделанные при остановленном
+// обработчике, находятся этим проходом. переподключения нет: при потере соединения run() завершается исключением,
+// и изменения до следующего запуска подхватываются тем же проходом
+class NotificationWorker {
+public:
+    static inline constexpr const char* channel = "representation_strings_changed";
+
+    NotificationWorker(SyntaxBlockWorkingMode working_mode = SyntaxBlockWorkingMode::UntilFirstError);
+    ~NotificationWorker();
+    NotificationWorker(const NotificationWorker&) = delete;
+    NotificationWorker& operator=(const NotificationWorker&) = delete;
+
+    void connect(std::string connection);
+    void connect(pqxx::connection* connection);
+    void disconnect();
+
+    void set_cache(VerificationCache* cache);
+    void set_tiered(bool tiered);
+    // время накопления уведомлений после первого из пачки
+    void set_batch_window(std::chrono::milliseconds batch_window);
+    // завершение run() после указанного времени без уведомлений, 0 — работать до stop()
+    void set_idle_timeout(std::chrono::seconds idle_timeout);
+
+    // блокирует вызывающий поток до stop() или истечения idle_timeout
+    void run();
+    // может вызываться из другого потока, run() завершится не позднее чем через poll_interval
+    void stop();
+
+    VerificationStatistics get_statistics() const;
+    size_t get_batches_count() const;
+
+private:
+    static constexpr std::chrono::milliseconds poll_interval { 1000 };
+    // пачка проверяется досрочно, если накопилось столько строк
+    static constexpr size_t max_batch_size = 10000;
+
+    SyntaxBlockWorkingMode working_mode;
+    VerificationCache* cache;
+    bool tiered;
+    std::chrono::milliseconds batch_window;
+    std::chrono::seconds idle_timeout;
+
+    pqxx::connection* connection;
+    bool owns_connection;
+    RepresentationStringRepository representation_string_repository;
+
+    std::set<long int> pending_ids;
+    std::atomic<bool> is_stopping;
+    VerificationStatistics statistics;
+    size_t batches_count;
+
+    void await_notifications(std::chrono::milliseconds timeout);
+    void check_strings(const std::set<long int>& representation_string_ids);
+};
\ No newline at end of file
@@ -106,6 +106,13 @@ bool SyntaxBlock::check_token_vector(const std::vector<std::variant<SimpleToken,
     return false;
 }
 
+// проверка строки без формирования сообщений
+bool SyntaxBlock::accept_token_vector(const std::vector<std::variant<SimpleToken, ComplexToken>>& combined_tokens)
+{
+    this->load_token_vector(combined_tokens);
+    return SyntaxBlock::CFG::String(this).check(false);
+}
+
 
 // Symbol
 void SyntaxBlock::CFG::Symbol::OpeningCurlyBrace::cancel(bool is_sending_signal)
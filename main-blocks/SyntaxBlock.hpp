@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <boost/format.hpp>
 #include <boost/signals2.hpp>
 #include <boost/bind/bind.hpp>
@@ -48,6 +49,10 @@ inline SyntaxBlockWorkingMode syntax_block_working_mode_from_string(const std::s
         return SyntaxBlockWorkingMode::UntilFirstError;
 }
 
+// версия грамматики; увеличивается при любом изменении правил проверки,
+// чтобы сохранённые результаты (VerificationCache) перестали использоваться
+inline constexpr uint32_t syntax_block_grammar_version = 1;
+
 class SyntaxBlock;
 
 class CFGTemplate {
@@ -93,6 +98,7 @@ public:
     void cancel_load_token();
     Message make_message(const VariableToken& token, const std::string& message_pool, const std::string& message_pool_identifier);
     bool check_token_vector(const std::vector<std::variant<SimpleToken, ComplexToken>>& combined_tokens, SyntaxBlockWorkingMode working_mode);
+    bool accept_token_vector(const std::vector<std::variant<SimpleToken, ComplexToken>>& combined_tokens);
 
     class CFG {
     public:
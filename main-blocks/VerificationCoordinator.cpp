@@ -0,0 +1,426 @@
+#include "VerificationCoordinator.hpp"
+
+#include <thread>
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+
+VerificationCoordinator::VerificationCoordinator(const std::vector<std::string>& worker_addresses, SyntaxBlockWorkingMode working_mode)
+    : worker_addresses(worker_addresses),
+      working_mode(working_mode),
+      shard_size(0),
+      completed_shards_count(0),
+      completed_shards_duration(0) {}
+
+VerificationCoordinator::~VerificationCoordinator() {}
+
+void VerificationCoordinator::set_shard_size(size_t shard_size)
+{
+    this->shard_size = shard_size;
+}
+
+CoordinatorStatistics VerificationCoordinator::get_statistics() const
+{
+    return statistics;
+}
+
+void VerificationCoordinator::check_strings(const std::vector<std::string>& strings, std::vector<std::set<Message>>& messages, std::vector<bool>& results)
+{
+    std::vector<size_t> worker_string_indexes;
+    std::vector<size_t> local_string_indexes;
+    worker_string_indexes.reserve(strings.size());
+    for (size_t string_index = 0; string_index < strings.size(); string_index++) {
+        if (is_valid_utf8(strings[string_index])) {
+            worker_string_indexes.push_back(string_index);
+        }
+        else {
+            local_string_indexes.push_back(string_index);
+        }
+    }
+
+    make_shards(worker_string_indexes.size(), default_strings_shard_size, [this, &strings, &worker_string_indexes](size_t first, size_t count) {
+        json request_strings = json::array();
+        for (size_t index = first; index < first + count; index++) {
+            request_strings.push_back(strings[worker_string_indexes[index]]);
+        }
+        return json { {"strings", std::move(request_strings)}, {"errors", syntax_block_working_mode_to_string(working_mode)} };
+    }, [](const Shard& shard, const std::vector<json>& records) {
+        // index в ответе рабочего — номер строки внутри шарда, начиная с 1 (ResultSerializer::JsonLines), по записи на строку
+        if (records.size() != shard.count) return false;
+        std::vector<bool> is_answered(shard.count, false);
+        for (const auto& record : records) {
+            if (!record.is_object() || !record.contains("index") || !record["index"].is_number_integer() ||
+                !record.contains("ok") || !record["ok"].is_boolean() || !record.contains("errors") || !record["errors"].is_array()) {
+                return false;
+            }
+            long long index = record["index"].get<long long>();
+            if (index < 1 || index > (long long)shard.count || is_answered[index - 1]) return false;
+            is_answered[index - 1] = true;
+
+            for (const auto& error : record["errors"]) {
+                if (!error.is_object() || !error.contains("token_index") || !error["token_index"].is_number_integer() ||
+                    !error.contains("value") || !error["value"].is_string() || !error.contains("pool") || !error["pool"].is_string() ||
+                    !error.contains("id") || !error["id"].is_string()) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    });
+    run_shards();
+
+    messages.assign(strings.size(), std::set<Message>());
+    results.assign(strings.size(), false);
+    for (const auto& shard : shards) {
+        for (const auto& record : shard.records.value()) {
+            int string_index = (int)worker_string_indexes[shard.first + record["index"].get<size_t>() - 1];
+            results[string_index] = record["ok"].get<bool>();
+            for (const auto& error : record["errors"]) {
+                messages[string_index].insert(Message(
+                    string_index,
+                    error["token_index"].get<int>(),
+                    error["value"].get<std::string>(),
+                    error["pool"].get<std::string>(),
+                    error["id"].get<std::string>()
+                ));
+            }
+        }
+    }
+
+    if (local_string_indexes.empty()) return;
+
+    std::vector<std::string> local_strings;
+    local_strings.reserve(local_string_indexes.size());
+    for (size_t string_index : local_string_indexes) {
+        local_strings.push_back(strings[string_index]);
+    }
+    std::vector<std::set<Message>> local_messages;
+    std::vector<bool> local_results;
+    VerificationSystem v_system = VerificationSystem(working_mode);
+    v_system.check_strings(local_strings, local_messages, local_results);
+
+    for (size_t index = 0; index < local_string_indexes.size(); index++) {
+        int string_index = (int)local_string_indexes[index];
+        results[string_index] = local_results[index];
+        for (const auto& message : local_messages[index]) {
+            messages[string_index].insert(Message(string_index, message.token_index, message.token_value, message.message_pool, message.message_pool_identifier));
+        }
+    }
+}
+
+std::vector<json> VerificationCoordinator::check_representations(const std::vector<int>& representation_ids)
+{
+    make_shards(representation_ids.size(), default_representations_shard_size, [this, &representation_ids](size_t first, size_t count) {
+        std::vector<int> shard_ids(representation_ids.begin() + first, representation_ids.begin() + first + count);
+        return json {
+            {"representation_ids", std::move(shard_ids)},
+            {"errors", syntax_block_working_mode_to_string(working_mode)},
+            {"write", false}
+        };
+    }, [&representation_ids](const Shard& shard, const std::vector<json>& records) {
+        // по записи на каждое представление шарда
+        if (records.size() != shard.count) return false;
+        std::vector<int> shard_ids(representation_ids.begin() + shard.first, representation_ids.begin() + shard.first + shard.count);
+        std::vector<int> answered_ids;
+        answered_ids.reserve(records.size());
+        for (const auto& record : records) {
+            if (!record.is_object() || !record.contains("representation_id") || !record["representation_id"].is_number_integer()) {
+                return false;
+            }
+            answered_ids.push_back(record["representation_id"].get<int>());
+            if (record.contains("error")) {
+                if (!record["error"].is_string()) return false;
+                continue;
+            }
+            if (!record.contains("ok") || !record["ok"].is_boolean() ||
+                !record.contains("representation_string_ids") || !record["representation_string_ids"].is_array() ||
+                !record.contains("content_hashes") || !record["content_hashes"].is_array() ||
+                !record.contains("validity") || !record["validity"].is_array() ||
+                record["representation_string_ids"].size() != record["validity"].size() ||
+                record["content_hashes"].size() != record["validity"].size()) {
+                return false;
+            }
+            for (const auto& representation_string_id : record["representation_string_ids"]) {
+                if (!representation_string_id.is_number_integer()) return false;
+            }
+            for (const auto& content_hash : record["content_hashes"]) {
+                if (!content_hash.is_number_unsigned()) return false;
+            }
+        }
+        std::sort(shard_ids.begin(), shard_ids.end());
+        std::sort(answered_ids.begin(), answered_ids.end());
+        return shard_ids == answered_ids;
+    });
+    run_shards();
+
+    std::vector<json> records;
+    records.reserve(representation_ids.size());
+    for (auto& shard : shards) {
+        for (auto& record : shard.records.value()) {
+            records.push_back(std::move(record));
+        }
+    }
+    return records;
+}
+
+void VerificationCoordinator::make_shards(size_t items_count, size_t default_shard_size, const std::function<json(size_t, size_t)>& make_request,
+    const std::function<bool(const Shard&, const std::vector<json>&)>& check_records)
+{
+    size_t items_per_shard = shard_size != 0 ? shard_size : default_shard_size;
+    this->check_records = check_records;
+
+    shards.clear();
+    pending_shards.clear();
+    for (size_t first = 0; first < items_count; first += items_per_shard) {
+        Shard shard;
+        shard.first = first;
+        shard.count = std::min(items_per_shard, items_count - first);
+        shard.request = make_request(shard.first, shard.count).dump();
+        pending_shards.push_back(shards.size());
+        shards.push_back(std::move(shard));
+    }
+    statistics.shards_count += shards.size();
+}
+
+void VerificationCoordinator::run_shards()
+{
+    if (worker_addresses.empty()) {
+        throw std::invalid_argument("Coordinator has no workers");
+    }
+
+    completed_shards_count = 0;
+    completed_shards_duration = std::chrono::steady_clock::duration(0);
+    error.clear();
+
+    std::vector<std::thread> workers;
+    workers.reserve(worker_addresses.size());
+    for (const auto& worker_address : worker_addresses) {
+        workers.emplace_back(&VerificationCoordinator::serve_worker, this, worker_address);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+    if (completed_shards_count != shards.size()) {
+        throw std::runtime_error("All workers failed, " + std::to_string(shards.size() - completed_shards_count) + " shards are not verified");
+    }
+}
+
+void VerificationCoordinator::serve_worker(const std::string& worker_address)
+{
+    boost::asio::io_context io_context;
+    VerificationDaemon::Socket socket(io_context);
+    try {
+        socket.connect(VerificationDaemon::resolve_endpoint(io_context, worker_address));
+    }
+    catch (const std::exception& e) {
+        fail_worker(worker_address, e.what());
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        worker_sockets.push_back(&socket);
+    }
+
+    std::string response;
+    while (true) {
+        std::optional<size_t> shard_index = take_shard();
+        if (!shard_index.has_value()) {
+            break;
+        }
+
+        // запрос шарда не меняется во время run_shards(), поэтому читается без блокировки
+        std::vector<json> records;
+        try {
+            VerificationDaemon::write_frame(socket, shards[*shard_index].request);
+            if (!VerificationDaemon::read_frame(socket, response)) {
+                throw std::runtime_error("Response frame is too large");
+            }
+            records = parse_response(response);
+        }
+        catch (const std::exception& e) {
+            release_shard(*shard_index);
+            fail_worker(worker_address, e.what());
+            break;
+        }
+
+        // ошибка запроса целиком (а не отдельного представления) повторится на любом рабочем
+        if (records.size() == 1 && records.front().is_object() && records.front().contains("error") && !records.front().contains("representation_id")) {
+            std::lock_guard<std::mutex> lock(mutex);
+            const json& request_error = records.front()["error"];
+            error = worker_address + ": " + (request_error.is_string() ? request_error.get<std::string>() : request_error.dump());
+            shutdown_workers();
+            shard_changed.notify_all();
+            break;
+        }
+
+        if (!check_records(shards[*shard_index], records)) {
+            release_shard(*shard_index);
+            fail_worker(worker_address, "Invalid response to a shard of " + std::to_string(shards[*shard_index].count) + " items");
+            break;
+        }
+
+        complete_shard(*shard_index, std::move(records));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::erase(worker_sockets, &socket);
+    boost::system::error_code error_code;
+    socket.close(error_code);
+}
+
+std::optional<size_t> VerificationCoordinator::take_shard()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        if (is_finished()) {
+            return std::nullopt;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (!pending_shards.empty()) {
+            size_t shard_index = pending_shards.front();
+            pending_shards.pop_front();
+            Shard& shard = shards[shard_index];
+            if (shard.running == 0) {
+                shard.started = now;
+            }
+            shard.running++;
+            return shard_index;
+        }
+
+        // очередь пуста: повторно выдаём шард, дольше всех выполняющийся у другого рабочего (не более двух копий)
+        auto rebalance_delay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(min_rebalance_delay);
+        if (completed_shards_count != 0) {
+            auto average_duration = completed_shards_duration / (std::chrono::steady_clock::rep)completed_shards_count;
+            rebalance_delay = std::max(rebalance_delay, 2 * average_duration);
+        }
+        std::optional<size_t> slowest_shard;
+        for (size_t shard_index = 0; shard_index < shards.size(); shard_index++) {
+            const Shard& shard = shards[shard_index];
+            if (shard.records.has_value() || shard.running != 1 || now - shard.started < rebalance_delay) {
+                continue;
+            }
+            if (!slowest_shard.has_value() || shard.started < shards[*slowest_shard].started) {
+                slowest_shard = shard_index;
+            }
+        }
+        if (slowest_shard.has_value()) {
+            shards[*slowest_shard].running++;
+            statistics.reissued_shards_count++;
+            return slowest_shard;
+        }
+
+        shard_changed.wait_for(lock, std::chrono::milliseconds(100));
+    }
+}
+
+void VerificationCoordinator::complete_shard(size_t shard_index, std::vector<json> records)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    Shard& shard = shards[shard_index];
+    shard.running--;
+    if (!shard.records.has_value()) {
+        shard.records = std::move(records);
+        completed_shards_count++;
+        completed_shards_duration += std::chrono::steady_clock::now() - shard.started;
+        if (is_finished()) {
+            shutdown_workers();
+        }
+    }
+    shard_changed.notify_all();
+}
+
+void VerificationCoordinator::release_shard(size_t shard_index)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    Shard& shard = shards[shard_index];
+    shard.running--;
+    if (!shard.records.has_value() && shard.running == 0) {
+        pending_shards.push_front(shard_index);
+    }
+    shard_changed.notify_all();
+}
+
+void VerificationCoordinator::fail_worker(const std::string& worker_address, const std::string& reason)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    // соединение закрыто shutdown_workers(): ответ на шард этого рабочего уже получен от другого
+    if (is_finished()) return;
+
+    statistics.failed_workers_count++;
+    std::cerr << "Worker " << worker_address << " failed: " << reason << std::endl;
+    shard_changed.notify_all();
+}
+
+bool VerificationCoordinator::is_finished() const
+{
+    return !error.empty() || completed_shards_count == shards.size();
+}
+
+void VerificationCoordinator::shutdown_workers()
+{
+    // чтение в потоках рабочих завершается с ошибкой, потоки выходят без ожидания ответа
+    for (auto* socket : worker_sockets) {
+        boost::system::error_code error_code;
+        socket->shutdown(VerificationDaemon::Socket::shutdown_both, error_code);
+    }
+}
+
+std::vector<json> VerificationCoordinator::parse_response(const std::string& response) const
+{
+    std::vector<json> records;
+    std::istringstream lines(response);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (!line.empty()) {
+            records.push_back(json::parse(line));
+        }
+    }
+    return records;
+}
+
+bool VerificationCoordinator::is_valid_utf8(std::string_view value)
+{
+    // строгая проверка (без избыточных последовательностей и суррогатов), как у json::dump()
+    size_t position = 0;
+    while (position < value.size()) {
+        unsigned char first = static_cast<unsigned char>(value[position]);
+        size_t length;
+        unsigned char min_second = 0x80, max_second = 0xBF;
+        if (first < 0x80) {
+            position++;
+            continue;
+        }
+        else if (first >= 0xC2 && first <= 0xDF) {
+            length = 2;
+        }
+        else if (first >= 0xE0 && first <= 0xEF) {
+            length = 3;
+            if (first == 0xE0) min_second = 0xA0;
+            if (first == 0xED) max_second = 0x9F;
+        }
+        else if (first >= 0xF0 && first <= 0xF4) {
+            length = 4;
+            if (first == 0xF0) min_second = 0x90;
+            if (first == 0xF4) max_second = 0x8F;
+        }
+        else {
+            return false;
+        }
+
+        if (position + length > value.size()) return false;
+        unsigned char second = static_cast<unsigned char>(value[position + 1]);
+        if (second < min_second || second > max_second) return false;
+        for (size_t offset = 2; offset < length; offset++) {
+            unsigned char next = static_cast<unsigned char>(value[position + offset]);
+            if (next < 0x80 || next > 0xBF) return false;
+        }
+        position += length;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <set>
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <optional>
+#include <functional>
+#include <condition_variable>
+#include "VerificationDaemon.hpp"
+
+struct CoordinatorStatistics {
+    size_t shards_count = 0;
+    size_t reissued_shards_count = 0;       // шарды, повторно выданные другому рабочему
+    size_t failed_workers_count = 0;
+};
+
+// распределённая проверка (режим --coordinator)
+// корпус (строки файлов или идентификаторы представлений) делится на шарды, которые рабочие процессы
+// (VerificationDaemon на локальном сокете или tcp://host:port) забирают из общей очереди по одному.
+// когда очередь пуста, освободившийся рабочий берёт шард, дольше всех выполняющийся у другого рабочего:
+// засчитывается первый ответ, поэтому медленный рабочий не задерживает весь запуск. шарды отключившегося рабочего
+// возвращаются в очередь, как и шарды, на которые рабочий вернул неполный или некорректный ответ.
+// ответы собираются по номеру шарда, результаты возвращаются в исходном порядке
+class VerificationCoordinator {
+public:
+    static inline constexpr size_t default_strings_shard_size = 256;
+    static inline constexpr size_t default_representations_shard_size = 16;
+    // шард выдаётся повторно не раньше, чем через удвоенное среднее время шарда, но не менее этой задержки
+    static inline constexpr std::chrono::milliseconds min_rebalance_delay { 500 };
+
+    VerificationCoordinator(const std::vector<std::string>& worker_addresses, SyntaxBlockWorkingMode working_mode = SyntaxBlockWorkingMode::UntilFirstError);
+    ~VerificationCoordinator();
+    VerificationCoordinator(const VerificationCoordinator&) = delete;
+    VerificationCoordinator& operator=(const VerificationCoordinator&) = delete;
+
+    // 0 — размер по умолчанию для вида корпуса
+    void set_shard_size(size_t shard_size);
+    // messages[i] и results[i] — результат strings[i], как у VerificationSystem::verify_strings;
+    // строки с некорректным UTF-8 нельзя передать в JSON без искажения, поэтому они проверяются в этом процессе
+    void check_strings(const std::vector<std::string>& strings, std::vector<std::set<Message>>& messages, std::vector<bool>& results);
+    // записи рабочих {"representation_id":..,"ok":..,"representation_string_ids":[..],"content_hashes":[..],"validity":[..]} в порядке representation_ids;
+    // рабочие в хранилище не пишут ("write": false): повторно выданный шард проверяется дважды, а validity записывает вызывающий один раз
+    std::vector<json> check_representations(const std::vector<int>& representation_ids);
+    CoordinatorStatistics get_statistics() const;
+
+private:
+    struct Shard {
+        size_t first;
+        size_t count;
+        std::string request;
+        std::optional<std::vector<json>> records;
+        int running = 0;
+        std::chrono::steady_clock::time_point started;
+    };
+
+    std::vector<std::string> worker_addresses;
+    SyntaxBlockWorkingMode working_mode;
+    size_t shard_size;
+    CoordinatorStatistics statistics;
+
+    std::mutex mutex;
+    std::condition_variable shard_changed;
+    std::vector<Shard> shards;
+    std::deque<size_t> pending_shards;
+    size_t completed_shards_count;
+    std::chrono::steady_clock::duration completed_shards_duration;
+    std::string error;
+    // соединения рабочих; после последнего шарда закрываются, чтобы не ждать ответов на повторно выданные шарды
+    std::vector<VerificationDaemon::Socket*> worker_sockets;
+    // проверка ответа рабочего на шард (число записей и их ключи); не меняется во время run_shards()
+    std::function<bool(const Shard&, const std::vector<json>&)> check_records;
+
+    void make_shards(size_t items_count, size_t default_shard_size, const std::function<json(size_t, size_t)>& make_request,
+        const std::function<bool(const Shard&, const std::vector<json>&)>& check_records);
+    // выполняет все шарды на рабочих; исключение, если рабочий вернул ошибку запроса или рабочих не осталось
+    void run_shards();
+    void serve_worker(const std::string& worker_address);
+    std::optional<size_t> take_shard();
+    void complete_shard(size_t shard_index, std::vector<json> records);
+    void release_shard(size_t shard_index);
+    void fail_worker(const std::string& worker_address, const std::string& reason);
+    bool is_finished() const;
+    void shutdown_workers();
+    std::vector<json> parse_response(const std::string& response) const;
+    static bool is_valid_utf8(std::string_view value);
+};
\ No newline at end of file
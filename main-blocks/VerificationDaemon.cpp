@@ -0,0 +1,357 @@
+#include "VerificationDaemon.hpp"
+
+#include <array>
+#include <algorithm>
+#include <thread>
+#include <sstream>
+#include <csignal>
+#include <filesystem>
+#include <stdexcept>
+#include "./../repositories/AlgorithmRepresentationRepository.hpp"
+#include "./../repositories/SnapshotCacheRepository.hpp"
+
+VerificationDaemon::VerificationDaemon(SyntaxBlockWorkingMode working_mode)
+    : working_mode(working_mode),
+      cache(nullptr),
+      tiered(true),
+      connection_pool(nullptr),
+      repository(nullptr),
+      threads_count(default_threads_count),
+      is_stopping(false),
+      requests_count(0) {}
+
+VerificationDaemon::~VerificationDaemon() {}
+
+void VerificationDaemon::set_cache(VerificationCache* cache)
+{
+    this->cache = cache;
+}
+
+void VerificationDaemon::set_tiered(bool tiered)
+{
+    this->tiered = tiered;
+}
+
+void VerificationDaemon::set_connection_pool(ConnectionPool* connection_pool)
+{
+    this->connection_pool = connection_pool;
+}
+
+void VerificationDaemon::set_snapshot_cache_directory(const std::string& snapshot_cache_directory)
+{
+    this->snapshot_cache_directory = snapshot_cache_directory;
+}
+
+void VerificationDaemon::set_repository(IAlgorithmRepresentationRepository* repository)
+{
+    this->repository = repository;
+}
+
+void VerificationDaemon::set_threads_count(size_t threads_count)
+{
+    this->threads_count = std::max<size_t>(threads_count, 1);
+}
+
+size_t VerificationDaemon::get_requests_count() const
+{
+    return requests_count;
+}
+
+bool VerificationDaemon::is_tcp_address(const std::string& address)
+{
+    return address.starts_with(tcp_prefix);
+}
+
+VerificationDaemon::Endpoint VerificationDaemon::resolve_endpoint(boost::asio::io_context& io_context, const std::string& address)
+{
+    if (!is_tcp_address(address)) {
+        return Endpoint(boost::asio::local::stream_protocol::endpoint(address));
+    }
+
+    std::string host_port = address.substr(tcp_prefix.size());
+    size_t separator = host_port.rfind(':');
+    if (separator == std::string::npos) {
+        throw std::invalid_argument("TCP address must be tcp://host:port: " + address);
+    }
+    // соединения не аутентифицируются, поэтому без явного адреса (tcp://:port) слушается только loopback
+    std::string host = host_port.substr(0, separator);
+    if (host.empty()) {
+        host = "127.0.0.1";
+    }
+    boost::asio::ip::tcp::resolver resolver(io_context);
+    auto results = resolver.resolve(host, host_port.substr(separator + 1));
+    if (results.empty()) {
+        throw std::runtime_error("Failed to resolve " + address);
+    }
+    return Endpoint(results.begin()->endpoint());
+}
+
+bool VerificationDaemon::read_frame(Socket& socket, std::string& frame)
+{
+    std::array<unsigned char, 4> length_bytes;
+    boost::asio::read(socket, boost::asio::buffer(length_bytes));
+    uint32_t length = length_bytes[0] | (length_bytes[1] << 8) | (length_bytes[2] << 16) | (uint32_t(length_bytes[3]) << 24);
+    if (length > max_frame_size) {
+        return false;
+    }
+
+    frame.resize(length);
+    boost::asio::read(socket, boost::asio::buffer(frame));
+    return true;
+}
+
+void VerificationDaemon::write_frame(Socket& socket, std::string_view frame)
+{
+    uint32_t length = static_cast<uint32_t>(frame.size());
+    std::array<unsigned char, 4> length_bytes = {
+        static_cast<unsigned char>(length),
+        static_cast<unsigned char>(length >> 8),
+        static_cast<unsigned char>(length >> 16),
+        static_cast<unsigned char>(length >> 24),
+    };
+    std::array<boost::asio::const_buffer, 2> buffers = {
+        boost::asio::buffer(length_bytes), boost::asio::buffer(frame)
+    };
+    boost::asio::write(socket, buffers);
+}
+
+void VerificationDaemon::run(const std::string& socket_path)
+{
+    // файл сокета остаётся после аварийного завершения предыдущего процесса
+    std::error_code error_code;
+    bool is_local = !is_tcp_address(socket_path);
+    if (is_local) {
+        std::filesystem::remove(socket_path, error_code);
+    }
+
+    Endpoint endpoint = resolve_endpoint(io_context, socket_path);
+    acceptor = std::make_unique<boost::asio::basic_socket_acceptor<boost::asio::generic::stream_protocol>>(io_context, endpoint.protocol());
+    if (!is_local) {
+        // рабочие перезапускаются на том же порту, не дожидаясь TIME_WAIT
+        acceptor->set_option(boost::asio::socket_base::reuse_address(true));
+    }
+    acceptor->bind(endpoint);
+    acceptor->listen();
+
+    boost::asio::signal_set signals(io_context, SIGINT, SIGTERM);
+    signals.async_wait([this](const boost::system::error_code& error, int) {
+        if (!error) {
+            stop();
+        }
+    });
+
+    is_stopping = false;
+    threads.reserve(threads_count);
+    for (size_t i = 0; i < threads_count; i++) {
+        threads.emplace_back(&VerificationDaemon::serve_connections, this);
+    }
+
+    accept();
+    io_context.run();
+
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        is_stopping = true;
+    }
+    connection_accepted.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+    sockets.clear();
+    acceptor.reset();
+    if (is_local) {
+        std::filesystem::remove(socket_path, error_code);
+    }
+}
+
+void VerificationDaemon::stop()
+{
+    boost::asio::post(io_context, [this]() {
+        if (acceptor) {
+            boost::system::error_code error_code;
+            acceptor->close(error_code);
+        }
+
+        // потоки соединений выходят из ожидания чтения
+        std::lock_guard<std::mutex> lock(connections_mutex);
+        for (auto& socket : sockets) {
+            boost::system::error_code error_code;
+            socket->shutdown(Socket::shutdown_both, error_code);
+        }
+        io_context.stop();
+    });
+}
+
+void VerificationDaemon::accept()
+{
+    acceptor->async_accept([this](const boost::system::error_code& error, Socket socket) {
+        if (error) {
+            return;
+        }
+
+        auto connection = std::make_shared<Socket>(std::move(socket));
+        {
+            std::lock_guard<std::mutex> lock(connections_mutex);
+            sockets.push_back(connection);
+            pending_sockets.push_back(connection);
+        }
+        connection_accepted.notify_one();
+        accept();
+    });
+}
+
+void VerificationDaemon::serve_connections()
+{
+    while (true) {
+        std::shared_ptr<Socket> socket;
+        {
+            std::unique_lock<std::mutex> lock(connections_mutex);
+            connection_accepted.wait(lock, [this]() { return is_stopping || !pending_sockets.empty(); });
+            if (is_stopping) {
+                // ожидающие соединения закрываются без обслуживания
+                pending_sockets.clear();
+                return;
+            }
+            socket = std::move(pending_sockets.front());
+            pending_sockets.pop_front();
+        }
+        serve(std::move(socket));
+    }
+}
+
+void VerificationDaemon::serve(std::shared_ptr<Socket> socket)
+{
+    try {
+        std::string request;
+        while (read_frame(*socket, request)) {
+            write_frame(*socket, handle_request(request));
+        }
+        // тело слишком большого кадра не читается, поэтому после ответа с ошибкой соединение закрывается
+        requests_count++;
+        write_frame(*socket, json { {"error", "Request frame exceeds " + std::to_string(max_frame_size) + " bytes"} }.dump() + "\n");
+    }
+    catch (const boost::system::system_error& e) {
+        // клиент закрыл соединение или демон останавливается
+    }
+
+    boost::system::error_code error_code;
+    socket->close(error_code);
+
+    std::lock_guard<std::mutex> lock(connections_mutex);
+    sockets.remove(socket);
+}
+
+std::string VerificationDaemon::handle_request(std::string_view request)
+{
+    requests_count++;
+
+    try {
+        json parsed_request = json::parse(request);
+        SyntaxBlockWorkingMode request_working_mode = parsed_request.contains("errors")
+            ? syntax_block_working_mode_from_string(parsed_request["errors"].get<std::string>())
+            : working_mode;
+
+        if (parsed_request.contains("strings")) {
+            return check_strings(parsed_request["strings"], request_working_mode);
+        }
+        if (parsed_request.contains("representation_ids")) {
+            return check_representations(parsed_request["representation_ids"], request_working_mode, parsed_request.value("write", true));
+        }
+        throw std::invalid_argument("Request must contain strings or representation_ids");
+    }
+    catch (const std::exception& e) {
+        return json { {"error", e.what()} }.dump() + "\n";
+    }
+}
+
+std::string VerificationDaemon::check_strings(const json& strings, SyntaxBlockWorkingMode working_mode)
+{
+    std::vector<std::string> request_strings = strings.get<std::vector<std::string>>();
+
+    VerificationSystem v_system = VerificationSystem(working_mode, OutputFormat::JsonLines);
+    v_system.set_cache(cache);
+    v_system.set_tiered(tiered);
+
+    std::ostringstream response;
+    v_system.check_strings(request_strings, response);
+    return response.str();
+}
+
+std::string VerificationDaemon::check_representations(const json& representation_ids, SyntaxBlockWorkingMode working_mode, bool write)
+{
+    std::vector<int> ids = representation_ids.get<std::vector<int>>();
+    std::string response;
+
+    if (repository != nullptr) {
+        std::lock_guard<std::mutex> lock(repository_mutex);
+        for (int representation_id : ids) {
+            check_representation(representation_id, *repository, working_mode, write, response);
+        }
+        return response;
+    }
+
+    if (connection_pool == nullptr) {
+        throw std::runtime_error("Daemon is not connected to a database");
+    }
+
+    // репозитории на соединении из пула, как у рабочих потоков BatchVerificationSystem
+    auto connection = connection_pool->acquire();
+
+    AlgorithmRepository algorithm_repository;
+    RepresentationRepository representation_repository;
+    RepresentationStringRepository representation_string_repository;
+    algorithm_repository.connect(connection.get());
+    representation_repository.connect(connection.get());
+    representation_string_repository.connect(connection.get());
+
+    std::unique_ptr<IAlgorithmRepresentationRepository> connection_repository = std::make_unique<AlgorithmRepresentationRepository>(
+        algorithm_repository, representation_repository, representation_string_repository);
+    if (!snapshot_cache_directory.empty()) {
+        connection_repository = std::make_unique<SnapshotCacheRepository>(std::move(connection_repository), snapshot_cache_directory);
+    }
+    connection_repository->connect(connection.get());
+
+    for (int representation_id : ids) {
+        check_representation(representation_id, *connection_repository, working_mode, write, response);
+    }
+    return response;
+}
+
+void VerificationDaemon::check_representation(int representation_id, IAlgorithmRepresentationRepository& repository, SyntaxBlockWorkingMode working_mode, bool write, std::string& response)
+{
+    auto representation = repository.get_by_id(representation_id);
+    if (!representation.has_value()) {
+        response += json { {"representation_id", representation_id}, {"error", "Representation not found"} }.dump() + "\n";
+        return;
+    }
+
+    VerificationSystem v_system = VerificationSystem(working_mode);
+    v_system.set_cache(cache);
+    v_system.set_tiered(tiered);
+    if (write) {
+        v_system.check_db_representation(representation.value(), repository);
+    }
+    else {
+        v_system.verify_db_representation(representation.value());
+    }
+
+    bool ok = true;
+    json representation_string_ids = json::array();
+    json content_hashes = json::array();
+    json validity = json::array();
+    for (const auto& representation_string : representation->representation_strings) {
+        const json& string_validity = representation_string.validity.value();
+        ok = ok && string_validity["ok"].get<bool>();
+        representation_string_ids.push_back(representation_string.representation_string_id);
+        content_hashes.push_back(VerificationCache::hash(representation_string.content));
+        validity.push_back(string_validity);
+    }
+    response += json {
+        {"representation_id", representation_id},
+        {"ok", ok},
+        {"representation_string_ids", std::move(representation_string_ids)},
+        {"content_hashes", std::move(content_hashes)},
+        {"validity", std::move(validity)}
+    }.dump() + "\n";
+}
\ No newline at end of file
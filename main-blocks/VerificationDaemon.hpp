@@ -0,0 +1,100 @@
+#pragma once
+
+#include <list>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <string_view>
+#include <condition_variable>
+#include <boost/asio.hpp>
+#include "VerificationSystem.hpp"
+#include "./../repositories/ConnectionPool.hpp"
+
+// долгоживущий процесс проверки (режим --daemon)
+// пулы сообщений, грамматика, потоки OpenMP и соединения с БД создаются один раз, а запросы принимаются
+// через локальный сокет или TCP (адрес вида tcp://host:port, tcp://:port — только 127.0.0.1). кадр: длина (uint32, little-endian) и содержимое; запрос — JSON, ответ — JSON Lines:
+//   {"strings": ["...", ...]}          -> по записи на строку, как в OutputFormat::JsonLines
+//   {"representation_ids": [1, 2]}     -> по записи на представление:
+//                                         {"representation_id":1,"ok":true,"representation_string_ids":[...],"content_hashes":[...],"validity":[...]}
+//                                         (content_hashes — VerificationCache::hash проверенного содержимого строк)
+// необязательное поле "errors" (UntilFirstError, AllErrors, AllErrorsInDetail) задаёт режим для запроса;
+// с "write": false validity представлений только возвращается, в хранилище её записывает клиент, иначе (по умолчанию) — демон;
+// аутентификации нет: любой, кто может подключиться к сокету, может записать validity в хранилище, поэтому
+// TCP-адрес следует оставлять на loopback или закрывать сетевыми правилами;
+// при ошибке ответ — одна запись {"error":"..."}. соединение обслуживает запросы по очереди, пока клиент его не закроет.
+// соединения обслуживаются постоянными потоками (set_threads_count): у каждого своя команда потоков OpenMP,
+// которая создаётся при первом запросе и переиспользуется; соединения сверх числа потоков ждут в очереди
+class VerificationDaemon {
+public:
+    using Socket = boost::asio::generic::stream_protocol::socket;
+    using Endpoint = boost::asio::generic::stream_protocol::endpoint;
+
+    static inline constexpr uint32_t max_frame_size = 64u << 20;
+    static inline constexpr size_t default_threads_count = 4;
+    static inline constexpr std::string_view tcp_prefix = "tcp://";
+
+    VerificationDaemon(SyntaxBlockWorkingMode working_mode = SyntaxBlockWorkingMode::UntilFirstError);
+    ~VerificationDaemon();
+    VerificationDaemon(const VerificationDaemon&) = delete;
+    VerificationDaemon& operator=(const VerificationDaemon&) = delete;
+
+    void set_cache(VerificationCache* cache);
+    void set_tiered(bool tiered);
+    // запросы representation_ids к PostgreSQL: каждый запрос получает соединение из пула
+    void set_connection_pool(ConnectionPool* connection_pool);
+    void set_snapshot_cache_directory(const std::string& snapshot_cache_directory);
+    // запросы representation_ids к хранилищам Memory и Snapshot: общий репозиторий, обращения идут по очереди
+    void set_repository(IAlgorithmRepresentationRepository* repository);
+    // число одновременно обслуживаемых соединений
+    void set_threads_count(size_t threads_count);
+
+    // блокирует вызывающий поток до stop(), SIGINT или SIGTERM; файл локального сокета пересоздаётся и удаляется при выходе
+    void run(const std::string& socket_path);
+    // может вызываться из другого потока
+    void stop();
+
+    // выполнение одного запроса без сокета
+    std::string handle_request(std::string_view request);
+    size_t get_requests_count() const;
+
+    // tcp://host:port — TCP (host разрешается через DNS), иначе путь локального сокета
+    static bool is_tcp_address(const std::string& address);
+    static Endpoint resolve_endpoint(boost::asio::io_context& io_context, const std::string& address);
+    // кадры протокола, общие для демона и клиентов (VerificationCoordinator); false — кадр больше max_frame_size
+    static bool read_frame(Socket& socket, std::string& frame);
+    static void write_frame(Socket& socket, std::string_view frame);
+
+private:
+
+    SyntaxBlockWorkingMode working_mode;
+    VerificationCache* cache;
+    bool tiered;
+    ConnectionPool* connection_pool;
+    std::string snapshot_cache_directory;
+    IAlgorithmRepresentationRepository* repository;
+    std::mutex repository_mutex;
+
+    boost::asio::io_context io_context;
+    std::unique_ptr<boost::asio::basic_socket_acceptor<boost::asio::generic::stream_protocol>> acceptor;
+    size_t threads_count;
+    std::vector<std::thread> threads;
+    // открытые соединения (обслуживаемые и ожидающие) закрываются в stop()
+    std::list<std::shared_ptr<Socket>> sockets;
+    std::deque<std::shared_ptr<Socket>> pending_sockets;
+    std::mutex connections_mutex;
+    std::condition_variable connection_accepted;
+    bool is_stopping;
+    std::atomic<size_t> requests_count;
+
+    void accept();
+    void serve_connections();
+    void serve(std::shared_ptr<Socket> socket);
+    std::string check_strings(const json& strings, SyntaxBlockWorkingMode working_mode);
+    std::string check_representations(const json& representation_ids, SyntaxBlockWorkingMode working_mode, bool write);
+    void check_representation(int representation_id, IAlgorithmRepresentationRepository& repository, SyntaxBlockWorkingMode working_mode, bool write, std::string& response);
+};
\ No newline at end of file
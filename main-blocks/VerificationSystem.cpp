@@ -1,68 +1,425 @@
 #include "VerificationSystem.hpp"
 
-VerificationSystem::VerificationSystem(SyntaxBlockWorkingMode working_mode)
+std::mutex VerificationSystem::events_mutex;
+
+VerificationSystem::VerificationSystem(SyntaxBlockWorkingMode working_mode, OutputFormat output_format)
 {
     this->working_mode = working_mode;
+    this->output_format = output_format;
+    this->cache = nullptr;
+    this->result_channel = nullptr;
+    this->tiered = true;
 }
 
 VerificationSystem::~VerificationSystem() {}
 
-void VerificationSystem::check_strings(const std::vector<std::string> strings, const std::string& output_file_path)
+void VerificationSystem::set_cache(VerificationCache* cache)
 {
-    int strings_count = strings.size();
+    this->cache = cache;
+}
 
-    std::vector<std::set<Message>> messages = std::vector<std::set<Message>>(strings_count);
-    std::vector<bool> results = std::vector<bool>(strings_count);
+void VerificationSystem::set_tiered(bool tiered)
+{
+    this->tiered = tiered;
+}
 
-    Debugger debugger = Debugger();
-    reset_events();
-    connect_events(debugger, messages);
+void VerificationSystem::set_result_channel(ResultChannel* result_channel)
+{
+    this->result_channel = result_channel;
+}
+
+VerificationStatistics VerificationSystem::get_statistics() const
+{
+    return statistics;
+}
 
+bool VerificationSystem::is_cancelled() const
+{
+    return result_channel != nullptr && result_channel->is_cancelled();
+}
+
+void VerificationSystem::publish_result(int string_index, bool result, const std::set<Message>& messages)
+{
+    if (result_channel == nullptr) {
+        return;
+    }
+
+    // у канала один писатель, поэтому публикации из потоков OpenMP идут по очереди;
+    // исключение не должно покинуть параллельную область, поэтому слишком длинная запись
+    // передаётся без сообщений, чтобы читатель всё равно получил результат строки
+    #pragma omp critical(result_channel)
+    {
+        try {
+            result_channel->publish(string_index, result, messages);
+        } catch (const std::runtime_error& e) {
+            std::cerr << "String " << string_index << ": " << e.what() << ", messages are not published" << std::endl;
+            result_channel->publish(string_index, result, {});
+        }
+    }
+}
+
+void VerificationSystem::verify_strings(const std::vector<std::string_view>& strings, std::vector<std::set<Message>>& messages, std::vector<bool>& results)
+{
+    int strings_count = strings.size();
+    if (result_channel != nullptr) {
+        result_channel->begin(strings_count);
+    }
+    // std::vector<bool> упакован побитово, поэтому параллельно пишем в std::vector<char>
+    std::vector<char> string_results = std::vector<char>(strings_count);
+
+    std::vector<uint64_t> hashes = std::vector<uint64_t>(strings_count);
     #pragma omp parallel for
     for (int string_index = 0; string_index < strings_count; string_index++) {
+        hashes[string_index] = VerificationCache::hash(strings[string_index]);
+    }
+
+    // одинаковые строки проверяются один раз: representatives[i] — индекс первой строки с тем же содержимым
+    std::vector<int> representatives = std::vector<int>(strings_count);
+    std::vector<int> unique_indices;
+    tsl::hopscotch_map<uint64_t, int> first_index_by_hash;
+    first_index_by_hash.reserve(strings_count);
+    for (int string_index = 0; string_index < strings_count; string_index++) {
+        auto [it, inserted] = first_index_by_hash.try_emplace(hashes[string_index], string_index);
+        if (!inserted && strings[it->second] == strings[string_index]) {
+            representatives[string_index] = it->second;
+            continue;
+        }
+        representatives[string_index] = string_index;
+        unique_indices.push_back(string_index);
+    }
+
+    size_t cache_hits_before = cache != nullptr ? cache->get_hits_count() : 0;
+
+    // первый уровень: кэш и быстрая проверка без сообщений (как в UntilFirstError);
+    // подробные проходы режимов AllErrors/AllErrorsInDetail нужны только строкам, которые её не прошли.
+    // для строк, принятых грамматикой целиком, check_all_inner_parts проверяет уже принятые
+    // подвыражения и сообщений не формирует, поэтому итоговый отчёт не меняется
+    bool is_tiered = tiered && working_mode != SyntaxBlockWorkingMode::UntilFirstError;
+    std::vector<char> needs_diagnostics = std::vector<char>(unique_indices.size());
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int unique_index = 0; unique_index < (int)unique_indices.size(); unique_index++) {
+        if (is_cancelled()) {
+            continue;
+        }
+        int string_index = unique_indices[unique_index];
+        std::string_view str = strings[string_index];
+
+        if (cache != nullptr) {
+            bool cached_result;
+            if (cache->find(hashes[string_index], str, working_mode, string_index, messages[string_index], cached_result)) {
+                string_results[string_index] = cached_result;
+                publish_result(string_index, cached_result, messages[string_index]);
+                continue;
+            }
+        }
+
+        if (is_tiered) {
+            MainBlock main_block = MainBlock(SyntaxBlockWorkingMode::UntilFirstError);
+            if (main_block.accept_string(str)) {
+                string_results[string_index] = true;
+                if (cache != nullptr) {
+                    cache->insert(hashes[string_index], str, working_mode, true, messages[string_index]);
+                }
+                publish_result(string_index, true, messages[string_index]);
+                continue;
+            }
+        }
+
+        needs_diagnostics[unique_index] = 1;
+    }
+
+    std::vector<int> diagnosed_indices;
+    for (int unique_index = 0; unique_index < (int)unique_indices.size(); unique_index++) {
+        if (needs_diagnostics[unique_index]) {
+            diagnosed_indices.push_back(unique_indices[unique_index]);
+        }
+    }
+
+    // второй уровень: полная диагностика в выбранном режиме
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (int diagnosed_index = 0; diagnosed_index < (int)diagnosed_indices.size(); diagnosed_index++) {
+        if (is_cancelled()) {
+            continue;
+        }
+        int string_index = diagnosed_indices[diagnosed_index];
+        std::string_view str = strings[string_index];
+
         MainBlock main_block = MainBlock(working_mode);
-        bool result = main_block.check_string(string_index, strings[string_index]);
-        results[string_index] = result;
+        bool result = main_block.check_string(string_index, str);
+        string_results[string_index] = result;
+
+        if (cache != nullptr) {
+            cache->insert(hashes[string_index], str, working_mode, result, messages[string_index]);
+        }
+        publish_result(string_index, result, messages[string_index]);
+    }
+
+    // результаты отменённой проверки неполны, поэтому они не раздаются и не записываются
+    if (is_cancelled()) {
+        throw std::runtime_error("Verification cancelled");
+    }
+
+    // раздаём результат и сообщения повторяющимся строкам с их собственным string_index
+    #pragma omp parallel for
+    for (int string_index = 0; string_index < strings_count; string_index++) {
+        int representative = representatives[string_index];
+        if (representative == string_index) {
+            continue;
+        }
+        string_results[string_index] = string_results[representative];
+        for (Message message : messages[representative]) {
+            message.string_index = string_index;
+            messages[string_index].insert(std::move(message));
+        }
+        publish_result(string_index, string_results[string_index], messages[string_index]);
+    }
+
+    results.assign(string_results.begin(), string_results.end());
+    if (result_channel != nullptr) {
+        result_channel->finish();
+    }
+
+    statistics.strings_count = strings_count;
+    statistics.unique_strings_count = unique_indices.size();
+    statistics.cache_hits_count = cache != nullptr ? cache->get_hits_count() - cache_hits_before : 0;
+    statistics.diagnosed_strings_count = diagnosed_indices.size();
+}
+
+void VerificationSystem::verify_strings(const std::vector<std::string>& strings, Debugger& debugger, std::vector<std::set<Message>>& messages, std::vector<bool>& results)
+{
+    verify_strings(std::vector<std::string_view>(strings.begin(), strings.end()), debugger, messages, results);
+}
+
+void VerificationSystem::verify_strings(const std::vector<std::string_view>& strings, Debugger& debugger, std::vector<std::set<Message>>& messages, std::vector<bool>& results)
+{
+    std::lock_guard<std::mutex> lock(events_mutex);
+    reset_events();
+    connect_events(debugger, messages);
+
+    verify_strings(strings, messages, results);
+    reset_events();
+}
+
+void VerificationSystem::write_results(std::ostream& output, Debugger& debugger, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results)
+{
+    switch (output_format) {
+        case OutputFormat::Text: {
+            std::ostringstream oss;
+            debugger.print_message_and_results(oss, messages, results);
+            output << oss.str();
+            break;
+        }
+
+        case OutputFormat::JsonLines:
+            ResultSerializer::JsonLines::write(output, messages, results);
+            break;
+
+        case OutputFormat::Binary:
+            ResultSerializer::Binary::write(output, messages, results);
+            break;
     }
+}
+
+void VerificationSystem::check_strings(const std::vector<std::string>& strings, std::ostream& output)
+{
+    std::vector<std::set<Message>> messages = std::vector<std::set<Message>>(strings.size());
+    std::vector<bool> results = std::vector<bool>(strings.size());
+
+    Debugger debugger = Debugger();
+    verify_strings(strings, debugger, messages, results);
+    write_results(output, debugger, messages, results);
+}
 
+void VerificationSystem::check_strings(const std::vector<std::string>& strings, std::vector<std::set<Message>>& messages, std::vector<bool>& results)
+{
+    messages.assign(strings.size(), std::set<Message>());
+    results.assign(strings.size(), false);
+
+    Debugger debugger = Debugger();
+    verify_strings(strings, debugger, messages, results);
+}
+
+void VerificationSystem::write_results_file(const std::string& output_file_path, Debugger& debugger, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results)
+{
     std::ofstream output_file;
-    output_file.open(output_file_path);
+    if (output_format == OutputFormat::Binary) {
+        output_file.open(output_file_path, std::ios::binary);
+    }
+    else {
+        output_file.open(output_file_path);
+    }
     if (!output_file.is_open()) {
         std::cerr << "Failed to open output file" << std::endl;
         return;
     }
 
-    debugger.print_message_and_results(output_file, messages, results);
+    if (output_format == OutputFormat::Text) {
+        debugger.print_message_and_results(output_file, messages, results);
+    }
+    else {
+        write_results(output_file, debugger, messages, results);
+    }
 
     output_file.close();
 }
 
+void VerificationSystem::check_strings(const std::vector<std::string> strings, const std::string& output_file_path)
+{
+    int strings_count = strings.size();
+
+    std::vector<std::set<Message>> messages = std::vector<std::set<Message>>(strings_count);
+    std::vector<bool> results = std::vector<bool>(strings_count);
+
+    Debugger debugger = Debugger();
+    verify_strings(strings, debugger, messages, results);
+    write_results_file(output_file_path, debugger, messages, results);
+}
+
+void VerificationSystem::check_strings(const std::vector<std::string_view>& strings, const std::string& output_file_path)
+{
+    std::vector<std::set<Message>> messages = std::vector<std::set<Message>>(strings.size());
+    std::vector<bool> results = std::vector<bool>(strings.size());
+
+    Debugger debugger = Debugger();
+    verify_strings(strings, debugger, messages, results);
+    write_results_file(output_file_path, debugger, messages, results);
+}
+
 void VerificationSystem::check_file(const std::string& input_file_path, const std::string& output_file_path)
 {
     std::vector<std::string> strings = DataUtils::FileUtils::read_strings_from_file(input_file_path);
     check_strings(strings, output_file_path);
 }
 
+std::vector<std::string> VerificationSystem::read_files(const std::vector<std::string>& input_file_paths, std::vector<size_t>& file_offsets)
+{
+    std::vector<std::string> strings;
+    file_offsets.clear();
+    file_offsets.reserve(input_file_paths.size() + 1);
+    for (const auto& input_file_path : input_file_paths) {
+        file_offsets.push_back(strings.size());
+        std::vector<std::string> file_strings = DataUtils::FileUtils::read_strings_from_file(input_file_path);
+        std::move(file_strings.begin(), file_strings.end(), std::back_inserter(strings));
+    }
+    file_offsets.push_back(strings.size());
+    return strings;
+}
+
+void VerificationSystem::check_files(const std::vector<std::string>& input_file_paths, const std::vector<std::string>& output_file_paths)
+{
+    // строки всех файлов проверяются одной очередью: одна команда потоков OpenMP на все файлы
+    // и общая дедупликация
+    std::vector<size_t> file_offsets;
+    std::vector<std::string> strings = read_files(input_file_paths, file_offsets);
+
+    std::vector<std::set<Message>> messages = std::vector<std::set<Message>>(strings.size());
+    std::vector<bool> results = std::vector<bool>(strings.size());
+
+    Debugger debugger = Debugger();
+    verify_strings(strings, debugger, messages, results);
+    write_files_results(output_file_paths, file_offsets, messages, results);
+}
+
+void VerificationSystem::write_files_results(const std::vector<std::string>& output_file_paths, const std::vector<size_t>& file_offsets, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results)
+{
+    Debugger debugger = Debugger();
+
+    // отчёт каждого файла — в порядке его строк, с номерами строк внутри файла
+    for (size_t file_index = 0; file_index < output_file_paths.size(); file_index++) {
+        size_t first_string = file_offsets[file_index];
+        size_t strings_count = file_offsets[file_index + 1] - first_string;
+
+        std::vector<std::set<Message>> file_messages = std::vector<std::set<Message>>(strings_count);
+        for (size_t string_index = 0; string_index < strings_count; string_index++) {
+            for (Message message : messages[first_string + string_index]) {
+                message.string_index = (int)string_index;
+                file_messages[string_index].insert(std::move(message));
+            }
+        }
+        std::vector<bool> file_results = std::vector<bool>(results.begin() + first_string, results.begin() + first_string + strings_count);
+
+        write_results_file(output_file_paths[file_index], debugger, file_messages, file_results);
+    }
+}
+
 void VerificationSystem::check_db_representation(AlgorithmRepresentation& representation)
+{
+    check_db_representation(representation, SharedRepository::get_instance().get_algorithm_representation_repository());
+}
+
+void VerificationSystem::check_db_representation(AlgorithmRepresentation& representation, IRepository<AlgorithmRepresentation>& repository)
+{
+    verify_db_representation(representation);
+
+    // запись в БД идёт вне блокировки и может пересекаться с проверкой других представлений
+    repository.update(representation);
+    representation.mark_clean();
+}
+
+void VerificationSystem::check_db_representation(AlgorithmRepresentation& representation, WriteBehindQueue& write_queue)
+{
+    verify_db_representation(representation);
+
+    write_queue.push(representation);
+    representation.mark_clean();
+}
+
+void VerificationSystem::check_db_strings(std::vector<RepresentationStringDTO>& representation_strings, IRepository<RepresentationStringDTO>& repository)
+{
+    std::vector<std::set<Message>> messages = std::vector<std::set<Message>>(representation_strings.size());
+    std::vector<bool> results = std::vector<bool>(representation_strings.size());
+
+    Debugger debugger = Debugger();
+
+    std::vector<std::string_view> strings;
+    strings.reserve(representation_strings.size());
+    for (const auto& representation_string : representation_strings) {
+        strings.push_back(representation_string.content);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(events_mutex);
+        reset_events();
+        connect_events(debugger, messages);
+
+        verify_strings(strings, messages, results);
+        reset_events();
+    }
+
+    for (size_t i = 0; i < representation_strings.size(); i++) {
+        representation_strings[i].validity = Debugger::make_validity(messages[i], results[i]);
+    }
+
+    repository.update_many(representation_strings);
+    for (auto& representation_string : representation_strings) {
+        representation_string.mark_clean();
+    }
+}
+
+void VerificationSystem::verify_db_representation(AlgorithmRepresentation& representation)
 {
     std::vector<std::set<Message>> messages = std::vector<std::set<Message>>(representation.representation_strings.size());
     std::vector<bool> results = std::vector<bool>(representation.representation_strings.size());
 
     Debugger debugger = Debugger();
-    reset_events();
-    connect_events(debugger, messages);
 
-    #pragma omp parallel for
-    for (int string_index = 0; string_index < (int)representation.representation_strings.size(); string_index++) {
-        MainBlock main_block = MainBlock(working_mode);
-        auto representation_string = representation.representation_strings[string_index];
-        bool result = main_block.check_string(string_index, representation_string.content);
-        results[string_index] = result;
+    std::vector<std::string_view> strings;
+    strings.reserve(representation.representation_strings.size());
+    for (const auto& representation_string : representation.representation_strings) {
+        strings.push_back(representation_string.content);
     }
 
-    debugger.print_message_and_results({"en", "ru"}, representation, messages, results);
-    
-    SharedRepository::get_instance().get_algorithm_representation_repository().update(representation);
+    {
+        std::lock_guard<std::mutex> lock(events_mutex);
+        reset_events();
+        connect_events(debugger, messages);
+
+        verify_strings(strings, messages, results);
+        reset_events();
+    }
+
+    debugger.print_message_and_results(representation, messages, results);
 }
 
 void VerificationSystem::reset_events()
@@ -1,22 +1,86 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <tsl/hopscotch_map.h>
 #include "TransliterationBlock.hpp"
 #include "LexicalBlock.hpp"
 #include "SyntaxBlock.hpp"
 #include "MainBlock.hpp"
 #include "./../utils/DataUtils.hpp"
 #include "./../utils/Debugger.hpp"
+#include "./../utils/ResultSerializer.hpp"
+#include "./../utils/VerificationCache.hpp"
+#include "./../utils/ResultChannel.hpp"
+#include "./../repositories/WriteBehindQueue.hpp"
+
+struct VerificationStatistics {
+    size_t strings_count = 0;
+    size_t unique_strings_count = 0;
+    size_t cache_hits_count = 0;
+    size_t diagnosed_strings_count = 0;
+
+    // доля строк, проверка которых не понадобилась из-за повторов
+    double dedup_ratio() const
+    {
+        return strings_count == 0 ? 0.0 : 1.0 - (double)unique_strings_count / strings_count;
+    }
+};
 
 class VerificationSystem {
 public:
-    VerificationSystem(SyntaxBlockWorkingMode working_mode = SyntaxBlockWorkingMode::UntilFirstError);
+    VerificationSystem(SyntaxBlockWorkingMode working_mode = SyntaxBlockWorkingMode::UntilFirstError, OutputFormat output_format = OutputFormat::Text);
     ~VerificationSystem();
 
     void check_strings(const std::vector<std::string> strings, const std::string& output_file_path);
+    // строки без копирования (например, представления сегмента разделяемой памяти Loader::view())
+    void check_strings(const std::vector<std::string_view>& strings, const std::string& output_file_path);
+    // отчёт в выбранном output_format пишется в поток (например, в ответ VerificationDaemon)
+    void check_strings(const std::vector<std::string>& strings, std::ostream& output);
+    // результаты без отчёта: messages[i] и results[i] — результат strings[i]
+    void check_strings(const std::vector<std::string>& strings, std::vector<std::set<Message>>& messages, std::vector<bool>& results);
     void check_file(const std::string& input_file_path, const std::string& output_file_path);
+    // проверка нескольких файлов за один проход, отчёт i-го входного файла пишется в output_file_paths[i]
+    void check_files(const std::vector<std::string>& input_file_paths, const std::vector<std::string>& output_file_paths);
+    // строки файлов подряд; file_offsets[i] — номер первой строки i-го файла, последний элемент — общее число строк
+    static std::vector<std::string> read_files(const std::vector<std::string>& input_file_paths, std::vector<size_t>& file_offsets);
+    // отчёты по файлам для результатов, полученных без verify_strings этого экземпляра (VerificationCoordinator)
+    void write_files_results(const std::vector<std::string>& output_file_paths, const std::vector<size_t>& file_offsets, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results);
     void check_db_representation(AlgorithmRepresentation& representation);
+    void check_db_representation(AlgorithmRepresentation& representation, IRepository<AlgorithmRepresentation>& repository);
+    // результаты записываются в БД фоновым потоком очереди, проверка возвращается сразу после постановки в очередь
+    void check_db_representation(AlgorithmRepresentation& representation, WriteBehindQueue& write_queue);
+    // отдельные строки (например, изменённые в разных представлениях), validity записывается одним update_many()
+    void check_db_strings(std::vector<RepresentationStringDTO>& representation_strings, IRepository<RepresentationStringDTO>& repository);
+    // validity строк представления заполняется без записи в хранилище (ответ рабочего координатору, который записывает сам)
+    void verify_db_representation(AlgorithmRepresentation& representation);
+    void set_cache(VerificationCache* cache);
+    void set_tiered(bool tiered);
+    // результаты по строкам публикуются в канал по мере готовности (в порядке завершения проверки);
+    // после отмены канала читателем проверка прерывается исключением, ничего не записав
+    void set_result_channel(ResultChannel* result_channel);
+    VerificationStatistics get_statistics() const;
 
 private:
     SyntaxBlockWorkingMode working_mode;
+    OutputFormat output_format;
+    VerificationCache* cache;
+    ResultChannel* result_channel;
+    VerificationStatistics statistics;
+    bool tiered;
+
+    // обработчики ошибок SyntaxBlock статические (общие для всех экземпляров),
+    // поэтому проверки из разных потоков выполняются по очереди
+    static std::mutex events_mutex;
 
+    void verify_strings(const std::vector<std::string_view>& strings, std::vector<std::set<Message>>& messages, std::vector<bool>& results);
+    void publish_result(int string_index, bool result, const std::set<Message>& messages);
+    // читатель канала результатов отменил проверку; строки после отмены не проверяются
+    bool is_cancelled() const;
+    void verify_strings(const std::vector<std::string>& strings, Debugger& debugger, std::vector<std::set<Message>>& messages, std::vector<bool>& results);
+    void verify_strings(const std::vector<std::string_view>& strings, Debugger& debugger, std::vector<std::set<Message>>& messages, std::vector<bool>& results);
+    void write_results(std::ostream& output, Debugger& debugger, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results);
+    void write_results_file(const std::string& output_file_path, Debugger& debugger, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results);
     void reset_events();
     void connect_events(int strings_count);
     void connect_events(Debugger& debugger, std::vector<std::set<Message>>& messages);
@@ -1,7 +1,12 @@
 #include "./main-blocks/VerificationSystem.hpp"
+#include "./main-blocks/BatchVerificationSystem.hpp"
+#include "./main-blocks/NotificationWorker.hpp"
+#include "./main-blocks/VerificationDaemon.hpp"
+#include "./main-blocks/VerificationCoordinator.hpp"
 #include "./utils/Debugger.hpp"
 #include "./utils/Settings.hpp"
 #include "./utils/DataUtils.hpp"
+#include "./utils/Loader.hpp"
 // #include 
 #include "./repositories/SharedRepository.hpp"
 #include <iostream>
@@ -10,9 +15,15 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <memory>
+#include <filesystem>
+#include <algorithm>
+#include <iterator>
 
 #include <chrono>
 
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/signal_set.hpp>
 #include <boost/program_options.hpp>
 namespace po = boost::program_options;
 
@@ -22,27 +33,47 @@ Settings parse_cmd_options(int argc, char* argv[])
 {
     Settings settings;
 
-    MainWorkMode work_mode = MainWorkMode::File;
+    std::string work_mode;
     std::string debug_mode;
     std::string errors;
     std::string language;
+    std::string cache_file;
+    std::string socket_path;
+    int daemon_threads;
+    std::string messages_override_file;
+    std::vector<std::string> workers;
+    int shard_size;
+    std::string publish_shm;
 
     std::string config_file_path;
 
     std::string input_file;
     std::string output_file;
+    std::string input_dir;
+    std::string input_shm;
+    std::string output_dir;
+    std::string output_format;
 
+    std::string storage;
+    std::string storage_directory;
     std::string db_connection;
     std::string algorithm_name;
     std::string algorithm_description;
-    int dimensionality;
+    std::vector<int> dimensionality;
     int iterations;
     std::string representation_file;
+    int pool_size;
+    int concurrency;
+    std::string snapshot_cache_dir;
+    int write_behind_depth;
+    int listen_window;
+    int idle_timeout;
+    std::string journal_file;
     
     po::options_description generic_options("Generic options");
     generic_options.add_options()
         ("help,h", "Print this help message.")
-        ("work-mode,W", po::value<std::string>(&debug_mode)->default_value("File"),
+        ("work-mode,W", po::value<std::string>(&work_mode)->default_value("File"),
             "Work mode. \"File\" or \"DB\".")
         ("config-file,C", po::value<std::string>(&config_file_path)->default_value("config.json"),
             "Config file path. Config contains other options.")
@@ -60,6 +91,26 @@ Settings parse_cmd_options(int argc, char* argv[])
             "Language of app. Available languages:\n"
             "  English - \tEnglish language\n"
             "  Russian - \tRussian language")
+        ("cache-file", po::value<std::string>(&cache_file)->default_value(""),
+            "Verification cache file path. Results of unchanged strings are taken from it.")
+        ("no-tiered", "Disable the fast accept pass before detailed diagnostics in All* errors modes.")
+        ("daemon", "Keep running and verify requests received over a socket (length-prefixed JSON, JSON Lines responses).")
+        ("socket", po::value<std::string>(&socket_path)->default_value("qdeterminant.sock"),
+            "Local socket path or tcp://host:port in daemon mode (tcp://:port listens on 127.0.0.1 only). "
+            "Connections are not authenticated: do not expose a TCP port to untrusted networks.")
+        ("daemon-threads", po::value<int>(&daemon_threads)->default_value(4),
+            "Connections served at once in daemon mode; each keeps its own warm OpenMP thread team.")
+        ("coordinator", "Split the corpus (File mode strings or DB representations) into shards and verify them on daemon workers.")
+        ("worker", po::value<std::vector<std::string>>(&workers)->composing(),
+            "Worker daemon address in coordinator mode (local socket path or tcp://host:port). Can be repeated.")
+        ("shard-size", po::value<int>(&shard_size)->default_value(0),
+            "Strings (File mode) or representations (DB mode) per shard in coordinator mode (0 - default: 256 / 16).")
+        ("publish-shm", po::value<std::string>(&publish_shm),
+            "Publish the strings of input-file (File mode) or of the found representation (DB mode) to a named shared memory segment "
+            "and keep it until SIGINT/SIGTERM, so that other processes can verify them with --input-shm.")
+        ("messages-override", po::value<std::string>(&messages_override_file)->default_value(""),
+            "JSON file with translated message texts replacing the built-in ones:\n"
+            "  {\"messages\": {\"ru\": {\"other\": {\"string\": \"...\"}}}}")
         ;
     
     po::options_description db_config_options("DB config options");
@@ -68,16 +119,40 @@ Settings parse_cmd_options(int argc, char* argv[])
             "DB connection string.\n"
             "  Example:\n"
             "  \"host=localhost port=5432 dbname=<dbname> user=<user> password=<password>\"")
+        ("storage", po::value<std::string>(&storage)->default_value("PostgreSQL"),
+            "Repository storage. Available storages:\n"
+            "  PostgreSQL - \tDB server (db-connection)\n"
+            "  Memory - \tin-process tables loaded from storage-dir, changes are discarded\n"
+            "  Snapshot - \tin-process tables loaded from storage-dir, changes are written back")
+        ("storage-dir", po::value<std::string>(&storage_directory)->default_value(""),
+            "Directory of representation snapshot files for Memory and Snapshot storages.")
         ("algorithm-name,n", po::value<std::string>(&algorithm_name)->default_value(""),
             "Algorithm name (string).")
         ("algorithm-description,d", po::value<std::string>(&algorithm_description)->default_value(""),
             "Algorithm description (string).")
-        ("size,s", po::value<int>(&dimensionality)->default_value(0),
-            "Size in dimensions. Dimensionality (integer).")
+        ("size,s", po::value<std::vector<int>>(&dimensionality)->multitoken(),
+            "Size in dimensions. Dimensionality (integers).")
         ("iterations,i", po::value<int>(&iterations)->default_value(0),
             "Iterations (integer).")
         ("representation-file,r", po::value<std::string>(&representation_file)->default_value(""),
             "Representation file (loaded from DB).")
+        ("batch,B", "Verify every representation matching the filter (all representations if no algorithm name is given).")
+        ("pool-size", po::value<int>(&pool_size)->default_value(4),
+            "Number of DB connections in batch mode.")
+        ("concurrency", po::value<int>(&concurrency)->default_value(4),
+            "Number of representations verified at the same time in batch mode.")
+        ("snapshot-cache-dir", po::value<std::string>(&snapshot_cache_dir)->default_value(""),
+            "Directory of local representation snapshots. Unchanged representations are loaded from it.")
+        ("write-behind-depth", po::value<int>(&write_behind_depth)->default_value(64),
+            "Number of verified representations queued for background write-back in batch mode (0 - write synchronously).")
+        ("listen", "Run as a worker: verify strings whose content changed (requires sql/migrations/002_representation_strings_notify.sql).")
+        ("listen-window", po::value<int>(&listen_window)->default_value(200),
+            "Milliseconds to collect change notifications before verifying them in listen mode.")
+        ("idle-timeout", po::value<int>(&idle_timeout)->default_value(0),
+            "Seconds without notifications after which listen mode exits (0 - run until killed).")
+        ("journal-file", po::value<std::string>(&journal_file)->default_value(""),
+            "Progress journal of batch mode (empty - no journal). Removed after a successful run.")
+        ("resume", "Continue an interrupted batch run from its progress journal.")
         ;
     
     po::options_description config_options("Configuration options");
@@ -86,6 +161,19 @@ Settings parse_cmd_options(int argc, char* argv[])
             "Output file path.")
         ("input-file,I", po::value<std::string>(&input_file)->default_value("input.txt"),
             "Input file path.")
+        ("input-dir", po::value<std::string>(&input_dir),
+            "Directory of input .txt files. Strings of all files are verified in one pass, reports are written to output-dir.")
+        ("recursive", "Include .txt files from subdirectories of input-dir.")
+        ("input-shm", po::value<std::string>(&input_shm),
+            "Name of a shared memory segment with input strings (published by another process with --publish-shm) used instead of input-file. "
+            "Strings are verified in place; the publisher must not rewrite the segment during verification.")
+        ("output-dir", po::value<std::string>(&output_dir),
+            "Directory of reports in input-dir mode (required, must differ from input-dir and must not be inside it with --recursive). Subdirectory structure is kept.")
+        ("output-format,F", po::value<std::string>(&output_format)->default_value("Text"),
+            "Output file format. Available formats:\n"
+            "  Text - \tlocalized text report\n"
+            "  jsonl - \tJSON Lines, one object per string\n"
+            "  bin - \tbinary records file with string table")
         ;
 
     po::options_description cmdline_options;
@@ -131,8 +219,32 @@ Settings parse_cmd_options(int argc, char* argv[])
     if (vm.count("language")) {
         settings.global_settings.language = Language::type_from_string(vm["language"].as<std::string>());
     }
+    if (vm.count("cache-file")) {
+        settings.global_settings.cache_file_path = vm["cache-file"].as<std::string>();
+    }
+    settings.global_settings.tiered_verification = vm.count("no-tiered") == 0;
+    settings.global_settings.daemon = vm.count("daemon") != 0;
+    if (vm.count("socket")) {
+        settings.global_settings.socket_path = vm["socket"].as<std::string>();
+    }
+    if (vm.count("daemon-threads")) {
+        settings.global_settings.daemon_threads = vm["daemon-threads"].as<int>();
+    }
+    if (vm.count("messages-override")) {
+        settings.global_settings.messages_override_file_path = vm["messages-override"].as<std::string>();
+    }
+    settings.global_settings.coordinator = vm.count("coordinator") != 0;
+    if (vm.count("worker")) {
+        settings.global_settings.workers = vm["worker"].as<std::vector<std::string>>();
+    }
+    if (vm.count("shard-size")) {
+        settings.global_settings.shard_size = vm["shard-size"].as<int>();
+    }
+    if (vm.count("publish-shm")) {
+        settings.global_settings.publish_shared_memory_name = vm["publish-shm"].as<std::string>();
+    }
 
-    switch (work_mode) {
+    switch (settings.global_settings.work_mode) {
         case MainWorkMode::File: {
             if (vm.count("input-file")) {
                 settings.file_settings.input_file_path = vm["input-file"].as<std::string>();
@@ -140,10 +252,29 @@ Settings parse_cmd_options(int argc, char* argv[])
             if (vm.count("output-file")) {
                 settings.file_settings.output_file_path = vm["output-file"].as<std::string>();
             }
+            if (vm.count("output-format")) {
+                settings.file_settings.output_format = output_format_from_string(vm["output-format"].as<std::string>());
+            }
+            if (vm.count("input-dir")) {
+                settings.file_settings.input_directory_path = vm["input-dir"].as<std::string>();
+            }
+            if (vm.count("output-dir")) {
+                settings.file_settings.output_directory_path = vm["output-dir"].as<std::string>();
+            }
+            settings.file_settings.recursive = vm.count("recursive") != 0;
+            if (vm.count("input-shm")) {
+                settings.file_settings.input_shared_memory_name = vm["input-shm"].as<std::string>();
+            }
             break;
         }
 
         case MainWorkMode::DB: {
+            if (vm.count("storage")) {
+                settings.db_settings.storage = repository_storage_from_string(vm["storage"].as<std::string>());
+            }
+            if (vm.count("storage-dir")) {
+                settings.db_settings.storage_directory = vm["storage-dir"].as<std::string>();
+            }
             if (vm.count("db-connection")) {
                 settings.db_settings.db_connection = vm["db-connection"].as<std::string>();
             }
@@ -162,6 +293,30 @@ Settings parse_cmd_options(int argc, char* argv[])
             if (vm.count("representation-file")) {
                 settings.db_settings.representation_file_path = vm["representation-file"].as<std::string>();
             }
+            settings.db_settings.batch = vm.count("batch") != 0;
+            if (vm.count("pool-size")) {
+                settings.db_settings.pool_size = vm["pool-size"].as<int>();
+            }
+            if (vm.count("concurrency")) {
+                settings.db_settings.concurrency = vm["concurrency"].as<int>();
+            }
+            if (vm.count("snapshot-cache-dir")) {
+                settings.db_settings.snapshot_cache_directory = vm["snapshot-cache-dir"].as<std::string>();
+            }
+            if (vm.count("write-behind-depth")) {
+                settings.db_settings.write_behind_depth = vm["write-behind-depth"].as<int>();
+            }
+            settings.db_settings.listen = vm.count("listen") != 0;
+            if (vm.count("listen-window")) {
+                settings.db_settings.listen_window = vm["listen-window"].as<int>();
+            }
+            if (vm.count("idle-timeout")) {
+                settings.db_settings.idle_timeout = vm["idle-timeout"].as<int>();
+            }
+            if (vm.count("journal-file")) {
+                settings.db_settings.journal_file_path = vm["journal-file"].as<std::string>();
+            }
+            settings.db_settings.resume = vm.count("resume") != 0;
             break;
         }
     }    
@@ -169,10 +324,410 @@ Settings parse_cmd_options(int argc, char* argv[])
     return settings;
 }
 
+void print_statistics(const Settings& settings, const VerificationStatistics& statistics)
+{
+    if (settings.global_settings.debug_mode != DebuggerWorkingMode::Verbose) {
+        return;
+    }
+    std::cerr << "Strings: " << statistics.strings_count
+        << ", unique: " << statistics.unique_strings_count
+        << ", dedup ratio: " << statistics.dedup_ratio()
+        << ", cache hits: " << statistics.cache_hits_count
+        << ", diagnosed: " << statistics.diagnosed_strings_count << std::endl;
+}
+
+// расширение отчёта в каталоге output-dir
+std::string output_file_extension(OutputFormat output_format)
+{
+    switch (output_format) {
+        case OutputFormat::JsonLines:
+            return ".jsonl";
+        case OutputFormat::Binary:
+            return ".bin";
+        default:
+            return ".txt";
+    }
+}
+
+// отчёт каждого .txt из input-dir пишется в output-dir по тому же относительному пути
+std::vector<std::string> get_directory_output_file_paths(const Settings& settings, const std::vector<std::string>& input_file_paths)
+{
+    const auto& file_settings = settings.file_settings;
+    if (file_settings.output_directory_path.empty()) {
+        throw std::invalid_argument("output-dir is required with input-dir");
+    }
+    std::filesystem::path input_directory = file_settings.input_directory_path;
+    std::filesystem::path output_directory = file_settings.output_directory_path;
+    if (std::filesystem::exists(output_directory) && std::filesystem::equivalent(input_directory, output_directory)) {
+        throw std::invalid_argument("output-dir must differ from input-dir");
+    }
+    // с --recursive отчёты прошлого запуска в подкаталоге input-dir попали бы во входные файлы следующего
+    if (file_settings.recursive) {
+        auto canonical_input_directory = std::filesystem::weakly_canonical(input_directory);
+        auto canonical_output_directory = std::filesystem::weakly_canonical(output_directory);
+        auto [input_end, output_end] = std::mismatch(canonical_input_directory.begin(), canonical_input_directory.end(),
+            canonical_output_directory.begin(), canonical_output_directory.end());
+        // weakly_canonical оставляет завершающий разделитель пустым элементом пути
+        if (input_end == canonical_input_directory.end() || (std::next(input_end) == canonical_input_directory.end() && input_end->empty())) {
+            throw std::invalid_argument("output-dir must not be inside input-dir with --recursive");
+        }
+    }
+
+    std::vector<std::string> output_file_paths;
+    output_file_paths.reserve(input_file_paths.size());
+    for (const auto& input_file_path : input_file_paths) {
+        std::filesystem::path output_file_path = output_directory / std::filesystem::relative(input_file_path, input_directory);
+        output_file_path.replace_extension(output_file_extension(file_settings.output_format));
+        std::filesystem::create_directories(output_file_path.parent_path());
+        output_file_paths.push_back(output_file_path.string());
+    }
+    return output_file_paths;
+}
+
+// режим каталога: строки всех файлов проверяются за один проход
+void check_directory(const Settings& settings, VerificationCache* verification_cache)
+{
+    const auto& file_settings = settings.file_settings;
+    std::vector<std::string> input_file_paths = DataUtils::FileUtils::get_txt_files_list_from_folder(file_settings.input_directory_path, file_settings.recursive);
+    std::vector<std::string> output_file_paths = get_directory_output_file_paths(settings, input_file_paths);
+
+    VerificationSystem v_system = VerificationSystem(settings.global_settings.errors_mode, file_settings.output_format);
+    v_system.set_cache(verification_cache);
+    v_system.set_tiered(settings.global_settings.tiered_verification);
+    v_system.check_files(input_file_paths, output_file_paths);
+    if (settings.global_settings.debug_mode == DebuggerWorkingMode::Verbose) {
+        std::cerr << "Files: " << input_file_paths.size() << std::endl;
+    }
+    print_statistics(settings, v_system.get_statistics());
+}
+
+// представления пакетной проверки: все (без имени алгоритма) или подходящие под фильтр
+std::vector<int> get_representation_ids(const Settings& settings, SharedRepository& shared_repository)
+{
+    std::vector<int> representation_ids;
+    if (settings.db_settings.algorithm_name.empty()) {
+        for (const auto& representation : shared_repository.get_representation_repository().get_all()) {
+            representation_ids.push_back(representation.representation_id);
+        }
+    }
+    else {
+        representation_ids = shared_repository.get_algorithm_representation_repository().get_ids_by_filter(settings.make_representation_filter());
+    }
+
+    if (representation_ids.size() == 0) {
+        throw std::runtime_error("Algorithm not found");
+    }
+    return representation_ids;
+}
+
+// пакетный режим над хранилищами Memory и Snapshot: пул соединений не нужен, представления проверяются по очереди
+// (строки каждого представления проверяются параллельно внутри VerificationSystem)
+void check_db_batch_in_memory(const Settings& settings, VerificationCache* verification_cache)
+{
+    auto& shared_repository = SharedRepository::get_instance();
+    shared_repository.open(settings.db_settings.storage, settings.db_settings.db_connection, settings.db_settings.storage_directory);
+    auto& repository = shared_repository.get_algorithm_representation_repository();
+
+    std::vector<int> representation_ids = get_representation_ids(settings, shared_repository);
+
+    VerificationStatistics statistics;
+    for (int representation_id : representation_ids) {
+        auto representation = repository.get_by_id(representation_id);
+        if (!representation.has_value()) {
+            continue;
+        }
+
+        VerificationSystem v_system = VerificationSystem(settings.global_settings.errors_mode);
+        v_system.set_cache(verification_cache);
+        v_system.set_tiered(settings.global_settings.tiered_verification);
+        v_system.check_db_representation(representation.value(), repository);
+
+        VerificationStatistics representation_statistics = v_system.get_statistics();
+        statistics.strings_count += representation_statistics.strings_count;
+        statistics.unique_strings_count += representation_statistics.unique_strings_count;
+        statistics.cache_hits_count += representation_statistics.cache_hits_count;
+        statistics.diagnosed_strings_count += representation_statistics.diagnosed_strings_count;
+    }
+
+    // хранилище Snapshot записывает изменённые представления в каталог
+    shared_repository.disconnect();
+    print_statistics(settings, statistics);
+}
+
+// пакетный режим: подходящие представления проверяются параллельно на соединениях из пула
+void check_db_batch(const Settings& settings, VerificationCache* verification_cache)
+{
+    if (settings.db_settings.storage != RepositoryStorage::PostgreSQL) {
+        check_db_batch_in_memory(settings, verification_cache);
+        return;
+    }
+
+    ConnectionPool connection_pool(settings.db_settings.db_connection, settings.db_settings.pool_size);
+
+    std::vector<int> representation_ids;
+    {
+        auto connection = connection_pool.acquire();
+        AlgorithmRepository algorithm_repository;
+        RepresentationRepository representation_repository;
+        RepresentationStringRepository representation_string_repository;
+        algorithm_repository.connect(connection.get());
+        representation_repository.connect(connection.get());
+        representation_string_repository.connect(connection.get());
+
+        if (settings.db_settings.algorithm_name.empty()) {
+            for (const auto& representation : representation_repository.get_all()) {
+                representation_ids.push_back(representation.representation_id);
+            }
+        }
+        else {
+            AlgorithmRepresentationRepository repository(algorithm_repository, representation_repository, representation_string_repository);
+            repository.connect(connection.get());
+            representation_ids = repository.get_ids_by_filter(settings.make_representation_filter());
+        }
+    }
+
+    if (representation_ids.size() == 0) {
+        throw std::runtime_error("Algorithm not found");
+    }
+    if (settings.db_settings.resume && settings.db_settings.journal_file_path.empty()) {
+        throw std::invalid_argument("--resume requires --journal-file");
+    }
+
+    // журнал привязан к режиму проверки и выборке: продолжать можно только запуск с теми же параметрами
+    std::unique_ptr<ProgressJournal> journal;
+    if (!settings.db_settings.journal_file_path.empty()) {
+        const auto& db_settings = settings.db_settings;
+        nlohmann::json run_key = { syntax_block_working_mode_to_string(settings.global_settings.errors_mode) };
+        if (!db_settings.algorithm_name.empty()) {
+            run_key.push_back(db_settings.algorithm_name);
+            run_key.push_back(db_settings.algorithm_description);
+            run_key.push_back(Language::type_to_string(settings.global_settings.language));
+            run_key.push_back(db_settings.dimensionality);
+            run_key.push_back(db_settings.iterations);
+        }
+        journal = std::make_unique<ProgressJournal>(db_settings.journal_file_path, run_key.dump());
+        if (db_settings.resume && !journal->load()) {
+            std::cerr << "Progress journal not found, starting from the beginning" << std::endl;
+        }
+    }
+
+    BatchVerificationSystem v_system = BatchVerificationSystem(connection_pool, settings.db_settings.concurrency, settings.global_settings.errors_mode);
+    v_system.set_journal(journal.get());
+    v_system.set_cache(verification_cache);
+    v_system.set_tiered(settings.global_settings.tiered_verification);
+    v_system.set_snapshot_cache_directory(settings.db_settings.snapshot_cache_directory);
+    v_system.set_write_behind_depth(std::max(settings.db_settings.write_behind_depth, 0));
+    v_system.check_db_representations(representation_ids);
+    print_statistics(settings, v_system.get_statistics());
+}
+
+// режим обработчика: проверяются только строки, о которых пришло уведомление об изменении
+void check_db_listen(const Settings& settings, VerificationCache* verification_cache)
+{
+    if (settings.db_settings.storage != RepositoryStorage::PostgreSQL) {
+        throw std::invalid_argument("Listen mode requires PostgreSQL storage");
+    }
+
+    NotificationWorker worker = NotificationWorker(settings.global_settings.errors_mode);
+    worker.set_cache(verification_cache);
+    worker.set_tiered(settings.global_settings.tiered_verification);
+    worker.set_batch_window(std::chrono::milliseconds(std::max(settings.db_settings.listen_window, 0)));
+    worker.set_idle_timeout(std::chrono::seconds(std::max(settings.db_settings.idle_timeout, 0)));
+    worker.connect(settings.db_settings.db_connection);
+    worker.run();
+    if (settings.global_settings.debug_mode == DebuggerWorkingMode::Verbose) {
+        std::cerr << "Batches: " << worker.get_batches_count() << std::endl;
+    }
+    print_statistics(settings, worker.get_statistics());
+}
+
+// текущие строки проверенных представлений: для PostgreSQL — одним запросом по идентификаторам,
+// для хранилищ Memory и Snapshot — по представлениям (данные уже в памяти)
+std::vector<RepresentationStringDTO> get_current_representation_strings(const std::vector<json>& records, IRepository<RepresentationStringDTO>& repository)
+{
+    auto* database_repository = dynamic_cast<RepresentationStringRepository*>(&repository);
+    if (database_repository != nullptr) {
+        std::vector<long int> ids;
+        for (const auto& record : records) {
+            if (!record.contains("error")) {
+                for (const auto& representation_string_id : record["representation_string_ids"]) {
+                    ids.push_back(representation_string_id.get<long int>());
+                }
+            }
+        }
+        return database_repository->get_by_ids(ids);
+    }
+
+    std::vector<RepresentationStringDTO> representation_strings;
+    for (const auto& record : records) {
+        if (!record.contains("error")) {
+            auto strings = repository.get_by_field("representation_id", std::to_string(record["representation_id"].get<int>()));
+            std::move(strings.begin(), strings.end(), std::back_inserter(representation_strings));
+        }
+    }
+    return representation_strings;
+}
+
+// режим координатора: шарды корпуса проверяются демонами-рабочими (--daemon), собранные результаты записываются здесь.
+// в режиме File отчёты пишутся как при обычной проверке файла или каталога, в режиме DB validity записывают рабочие
+void run_coordinator(const Settings& settings)
+{
+    if (settings.global_settings.workers.empty()) {
+        throw std::invalid_argument("Coordinator mode requires at least one worker");
+    }
+
+    VerificationCoordinator coordinator = VerificationCoordinator(settings.global_settings.workers, settings.global_settings.errors_mode);
+    coordinator.set_shard_size(std::max(settings.global_settings.shard_size, 0));
+
+    switch (settings.global_settings.work_mode) {
+        case MainWorkMode::File: {
+            const auto& file_settings = settings.file_settings;
+            std::vector<std::string> input_file_paths;
+            std::vector<std::string> output_file_paths;
+            if (!file_settings.input_directory_path.empty()) {
+                input_file_paths = DataUtils::FileUtils::get_txt_files_list_from_folder(file_settings.input_directory_path, file_settings.recursive);
+                output_file_paths = get_directory_output_file_paths(settings, input_file_paths);
+            }
+            else {
+                input_file_paths.push_back(file_settings.input_file_path);
+                output_file_paths.push_back(file_settings.output_file_path);
+            }
+
+            std::vector<size_t> file_offsets;
+            std::vector<std::string> strings = VerificationSystem::read_files(input_file_paths, file_offsets);
+            std::vector<std::set<Message>> messages;
+            std::vector<bool> results;
+            coordinator.check_strings(strings, messages, results);
+
+            VerificationSystem v_system = VerificationSystem(settings.global_settings.errors_mode, file_settings.output_format);
+            v_system.write_files_results(output_file_paths, file_offsets, messages, results);
+            break;
+        }
+
+        case MainWorkMode::DB: {
+            auto& shared_repository = SharedRepository::get_instance();
+            shared_repository.open(settings.db_settings.storage, settings.db_settings.db_connection, settings.db_settings.storage_directory);
+            std::vector<int> representation_ids = get_representation_ids(settings, shared_repository);
+
+            // рабочие validity не записывают: первый ответ на каждый шард записывается здесь одним update_many
+            std::vector<json> records = coordinator.check_representations(representation_ids);
+            auto& representation_string_repository = shared_repository.get_representation_string_repository();
+            std::vector<RepresentationStringDTO> current_strings = get_current_representation_strings(records, representation_string_repository);
+
+            // validity записывается, только если содержимое строки в хранилище не изменилось после проверки
+            // (хэш VerificationCache::hash из ответа рабочего); изменённые строки пропускаются — триггер
+            // миграции 002 уже сбросил их validity, и их проверит NotificationWorker или следующий запуск
+            tsl::hopscotch_map<long int, std::pair<uint64_t, const json*>> checked_strings;
+            size_t valid_count = 0;
+            for (const auto& record : records) {
+                int representation_id = record["representation_id"].get<int>();
+                if (record.contains("error")) {
+                    std::cerr << "Representation " << representation_id << ": " << record["error"].get<std::string>() << std::endl;
+                    continue;
+                }
+                const auto& validity = record["validity"];
+                for (size_t i = 0; i < validity.size(); i++) {
+                    checked_strings[record["representation_string_ids"][i].get<long int>()] = { record["content_hashes"][i].get<uint64_t>(), &validity[i] };
+                }
+                if (record["ok"].get<bool>()) {
+                    valid_count++;
+                }
+            }
+
+            std::vector<RepresentationStringDTO> updated_strings;
+            updated_strings.reserve(checked_strings.size());
+            size_t changed_count = 0;
+            for (auto& representation_string : current_strings) {
+                auto checked_string = checked_strings.find(representation_string.representation_string_id);
+                if (checked_string == checked_strings.end()) {
+                    continue;
+                }
+                if (VerificationCache::hash(representation_string.content) != checked_string->second.first) {
+                    changed_count++;
+                    continue;
+                }
+                // в хранилище уходит только validity: содержимое помечено как загруженное
+                representation_string.mark_clean();
+                representation_string.validity = *checked_string->second.second;
+                updated_strings.push_back(std::move(representation_string));
+            }
+            representation_string_repository.update_many(updated_strings);
+            shared_repository.disconnect();
+
+            if (changed_count > 0) {
+                std::cerr << changed_count << " representation strings changed during verification, their validity is not written" << std::endl;
+            }
+            if (settings.global_settings.debug_mode == DebuggerWorkingMode::Verbose) {
+                std::cerr << "Representations: " << representation_ids.size() << ", valid: " << valid_count << std::endl;
+            }
+            break;
+        }
+
+        default:
+            throw std::invalid_argument("Unknown work mode");
+    }
+
+    if (settings.global_settings.debug_mode == DebuggerWorkingMode::Verbose) {
+        auto statistics = coordinator.get_statistics();
+        std::cerr << "Shards: " << statistics.shards_count
+            << ", reissued: " << statistics.reissued_shards_count
+            << ", failed workers: " << statistics.failed_workers_count << std::endl;
+    }
+}
+
+// публикация строк для --input-shm: сегмент удаляется при выходе, поэтому процесс ждёт SIGINT/SIGTERM
+void publish_shared_memory(const Settings& settings)
+{
+    const std::string& name = settings.global_settings.publish_shared_memory_name;
+    SharedMemoryName shared_memory_name(name.begin(), name.end());
+    Loader::load(settings, shared_memory_name);
+    if (settings.global_settings.debug_mode == DebuggerWorkingMode::Verbose) {
+        std::cerr << "Published " << Loader::view(shared_memory_name).size() << " strings to " << name << std::endl;
+    }
+
+    boost::asio::io_context io_context;
+    boost::asio::signal_set signals(io_context, SIGINT, SIGTERM);
+    signals.async_wait([&io_context](const boost::system::error_code&, int) {
+        io_context.stop();
+    });
+    io_context.run();
+}
+
+// режим демона: запросы на проверку строк и представлений принимаются через локальный сокет или TCP до SIGINT/SIGTERM
+void run_daemon(const Settings& settings, VerificationCache* verification_cache)
+{
+    VerificationDaemon daemon = VerificationDaemon(settings.global_settings.errors_mode);
+    daemon.set_cache(verification_cache);
+    daemon.set_tiered(settings.global_settings.tiered_verification);
+    daemon.set_threads_count(std::max(settings.global_settings.daemon_threads, 1));
+
+    std::unique_ptr<ConnectionPool> connection_pool;
+    if (settings.global_settings.work_mode == MainWorkMode::DB) {
+        if (settings.db_settings.storage == RepositoryStorage::PostgreSQL) {
+            connection_pool = std::make_unique<ConnectionPool>(settings.db_settings.db_connection, std::max(settings.db_settings.pool_size, 1));
+            daemon.set_connection_pool(connection_pool.get());
+            daemon.set_snapshot_cache_directory(settings.db_settings.snapshot_cache_directory);
+        }
+        else {
+            SharedRepository::get_instance().open(settings.db_settings.storage, settings.db_settings.db_connection, settings.db_settings.storage_directory);
+            daemon.set_repository(&SharedRepository::get_instance().get_algorithm_representation_repository());
+        }
+    }
+
+    daemon.run(settings.global_settings.socket_path);
+    if (settings.global_settings.work_mode == MainWorkMode::DB && settings.db_settings.storage != RepositoryStorage::PostgreSQL) {
+        SharedRepository::get_instance().disconnect();
+    }
+}
+
 int main(int argc, char* argv[])
 {
     Settings settings = parse_cmd_options(argc, argv);
 
+    if (settings.global_settings.debug_mode == DebuggerWorkingMode::None) {
+        return 0;
+    }
+
     switch (settings.global_settings.language) {
         case Language::Type::English:
             SharedRepository::get_instance().get_message_storage().switch_language(Language::Type::English);
@@ -186,58 +741,95 @@ int main(int argc, char* argv[])
             break;
     }
 
-    if (settings.global_settings.debug_mode == DebuggerWorkingMode::None) {
-        return 0;
+    if (!settings.global_settings.messages_override_file_path.empty()) {
+        SharedRepository::get_instance().load_message_overrides(settings.global_settings.messages_override_file_path);
+    }
+
+    std::unique_ptr<VerificationCache> verification_cache;
+    if (!settings.global_settings.cache_file_path.empty()) {
+        verification_cache = std::make_unique<VerificationCache>(settings.global_settings.cache_file_path);
     }
 
     try {
+        if (settings.global_settings.daemon) {
+            run_daemon(settings, verification_cache.get());
+            if (verification_cache) {
+                verification_cache->save();
+            }
+            return 0;
+        }
+        if (settings.global_settings.coordinator) {
+            run_coordinator(settings);
+            return 0;
+        }
+        if (!settings.global_settings.publish_shared_memory_name.empty()) {
+            publish_shared_memory(settings);
+            return 0;
+        }
+
         switch (settings.global_settings.work_mode) {
             case MainWorkMode::File: {
-                VerificationSystem v_system = VerificationSystem(settings.global_settings.errors_mode);
-                v_system.check_file(settings.file_settings.input_file_path, settings.file_settings.output_file_path);
+                if (!settings.file_settings.input_directory_path.empty()) {
+                    check_directory(settings, verification_cache.get());
+                    break;
+                }
+                VerificationSystem v_system = VerificationSystem(settings.global_settings.errors_mode, settings.file_settings.output_format);
+                v_system.set_cache(verification_cache.get());
+                v_system.set_tiered(settings.global_settings.tiered_verification);
+                if (!settings.file_settings.input_shared_memory_name.empty()) {
+                    const std::string& name = settings.file_settings.input_shared_memory_name;
+                    v_system.check_strings(Loader::view(SharedMemoryName(name.begin(), name.end())), settings.file_settings.output_file_path);
+                }
+                else {
+                    v_system.check_file(settings.file_settings.input_file_path, settings.file_settings.output_file_path);
+                }
+                print_statistics(settings, v_system.get_statistics());
                 break;
             }
 
             case MainWorkMode::DB: {
-                SharedRepository::get_instance().connect(settings.db_settings.db_connection);
-                auto algorithm_representations = SharedRepository::get_instance()
-                    .get_algorithm_representation_repository()
-                    .get_by_field("name", settings.db_settings.algorithm_name);
-                
-                if (algorithm_representations.size() == 0) {
-                    throw std::runtime_error("Algorithm not found by name");
+                if (settings.db_settings.listen) {
+                    check_db_listen(settings, verification_cache.get());
+                    break;
                 }
-                // std::cout << "Found " << algorithm_representations.size() << " algorithm representations" << std::endl;
-
-                // фильтруем по описанию, размерности и итерациям
-                std::vector<AlgorithmRepresentation> filtered_algorithm_representations;
-                for (AlgorithmRepresentation algorithm_representation : algorithm_representations) {
-                    std::string current_lang = settings.global_settings.language == Language::Type::English ? "en" : "ru";
-                    if (!algorithm_representation.algorithm.description[current_lang].empty() &&
-                            algorithm_representation.algorithm.description[current_lang] != "-" &&
-                            algorithm_representation.algorithm.description[current_lang] != settings.db_settings.algorithm_description) {
-                        continue;
-                    }
-                    if (algorithm_representation.representation.dimensionality != settings.db_settings.dimensionality) {
-                        continue;
-                    }
-                    if (algorithm_representation.representation.iterations != settings.db_settings.iterations) {
-                        continue;
-                    }
-                    filtered_algorithm_representations.push_back(algorithm_representation);
+                if (settings.db_settings.batch) {
+                    check_db_batch(settings, verification_cache.get());
+                    break;
+                }
+
+                if (!settings.db_settings.snapshot_cache_directory.empty()) {
+                    SharedRepository::get_instance().enable_snapshot_cache(settings.db_settings.snapshot_cache_directory);
                 }
-                // std::cout << "Filtered. " << filtered_algorithm_representations.size() << " algorithm representations remains" << std::endl;
+                SharedRepository::get_instance().open(settings.db_settings.storage, settings.db_settings.db_connection, settings.db_settings.storage_directory);
+                auto filtered_algorithm_representations = SharedRepository::get_instance()
+                    .get_algorithm_representation_repository()
+                    .get_by_filter(settings.make_representation_filter());
 
                 if (filtered_algorithm_representations.size() == 0) {
+                    // имя не найдено вовсе (код 1) или не подошли описание, размерность и итерации (код 12)
+                    auto named_algorithm_representations = SharedRepository::get_instance()
+                        .get_algorithm_representation_repository()
+                        .get_by_field("name", settings.db_settings.algorithm_name);
+                    if (named_algorithm_representations.size() == 0) {
+                        throw std::runtime_error("Algorithm not found by name");
+                    }
                     throw std::runtime_error("Algorithm not found");
                 }
                 auto filtered_algorithm_representation = filtered_algorithm_representations[0];
 
                 VerificationSystem v_system = VerificationSystem(settings.global_settings.errors_mode);
+                v_system.set_cache(verification_cache.get());
+                v_system.set_tiered(settings.global_settings.tiered_verification);
                 v_system.check_db_representation(filtered_algorithm_representation);
+                SharedRepository::get_instance().disconnect();
+                print_statistics(settings, v_system.get_statistics());
                 break;
             }
         }
+
+        if (verification_cache) {
+            verification_cache->save();
+        }
     }
     catch (const pqxx::broken_connection& e) {
         // std::cerr << "Error: " << e.what() << std::endl;
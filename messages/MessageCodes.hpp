@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <optional>
+
+#include "MessageTables.hpp"
+
+// языконезависимые коды сообщений (номер пула и номер сообщения в пуле)
+// коды хранятся в БД (поле validity), поэтому новые пулы и сообщения добавляются только в конец
+struct MessageCode {
+    short pool;
+    short message;
+
+    bool operator==(const MessageCode& other) const = default;
+};
+
+namespace MessageCodes {
+    // имена пулов и сообщений генерируются из каталогов res/values-en/messages.json (MessageTables.hpp)
+    using MessageTables::pools;
+    using MessageTables::messages;
+
+    static_assert(std::size(pools) == std::size(messages));
+
+    inline std::optional<MessageCode> find(std::string_view pool, std::string_view message)
+    {
+        for (short pool_index = 0; pool_index < (short)std::size(pools); pool_index++) {
+            if (pools[pool_index] != pool) {
+                continue;
+            }
+            for (short message_index = 0; message_index < (short)messages[pool_index].size(); message_index++) {
+                if (messages[pool_index][message_index] == message) {
+                    return MessageCode { pool_index, message_index };
+                }
+            }
+            return std::nullopt;
+        }
+        return std::nullopt;
+    }
+
+    inline bool is_valid(const MessageCode& code)
+    {
+        return code.pool >= 0 && code.pool < (short)std::size(pools) &&
+            code.message >= 0 && code.message < (short)messages[code.pool].size();
+    }
+
+    // номер сообщения в плоских таблицах текстов MessageTables::texts
+    inline size_t index(const MessageCode& code)
+    {
+        return MessageTables::pool_offsets[code.pool] + code.message;
+    }
+
+    inline std::string pool_name(const MessageCode& code)
+    {
+        return std::string(pools[code.pool]);
+    }
+
+    inline std::string message_name(const MessageCode& code)
+    {
+        return std::string(messages[code.pool][code.message]);
+    }
+}
\ No newline at end of file
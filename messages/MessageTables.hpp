@@ -0,0 +1,872 @@
+#pragma once
+
+// сгенерировано tools/message_tables_generator.cpp из res/values-*/messages.json и res/values-*/tui_messages.json,
+// вручную не редактируется: после изменения каталогов генератор запускается заново
+
+#include <span>
+#include <string_view>
+
+namespace MessageTables {
+    inline constexpr std::string_view languages[] = {
+        "en",
+        "ru",
+    };
+
+    // сообщения проверки (messages.json); порядок задаёт коды MessageCode
+
+    inline constexpr std::string_view other_messages[] = {
+        "string",
+        "position",
+        "result",
+        "success",
+        "failure",
+    };
+
+    inline constexpr std::string_view symbol_messages[] = {
+        "opening_curly_brace",
+        "closing_curly_brace",
+        "opening_parenthesis",
+        "closing_parenthesis",
+        "comma",
+        "colon",
+        "semicolon",
+        "quotation_mark",
+        "equal_sign",
+        "comparison_sign",
+        "exclamation_mark",
+        "arithmetic_sign",
+        "logical_sign",
+    };
+
+    inline constexpr std::string_view special_identifier_messages[] = {
+        "operation",
+        "operand_of_unary_operation",
+        "first_operand_of_binary_operation",
+        "second_operand_of_binary_operation",
+        "v",
+        "no",
+        "real",
+        "solution",
+        "modulus",
+        "square_of_number",
+        "square_root_of_number",
+    };
+
+    inline constexpr std::string_view variable_messages[] = {
+        "edge",
+        "identifier",
+        "integer",
+        "variable",
+    };
+
+    inline constexpr std::string_view operation_messages[] = {
+        "logical",
+        "arithmetic",
+        "operation",
+    };
+
+    inline constexpr std::string_view string_messages[] = {
+        "string",
+        "beginning",
+        "logical",
+        "arithmetic",
+        "arithmetic_no_real_solution",
+    };
+
+    inline constexpr std::string_view string_inner_messages[] = {
+        "operation",
+        "first_operand_of_binary_operation",
+        "second_operand_of_binary_operation",
+        "operand_binary",
+        "operand_unary",
+        "operand_variable",
+        "operand",
+        "inner",
+    };
+
+    inline constexpr std::string_view pools[] = {
+        "other",
+        "symbol",
+        "special_identifier",
+        "variable",
+        "operation",
+        "string",
+        "string_inner",
+    };
+
+    inline constexpr std::span<const std::string_view> messages[] = {
+        other_messages,
+        symbol_messages,
+        special_identifier_messages,
+        variable_messages,
+        operation_messages,
+        string_messages,
+        string_inner_messages,
+    };
+
+    inline constexpr short pool_offsets[] = {
+        0,
+        5,
+        18,
+        29,
+        33,
+        36,
+        41,
+    };
+
+    inline constexpr size_t messages_count = 49;
+
+    enum class MessageId : short {
+        other_string,
+        other_position,
+        other_result,
+        other_success,
+        other_failure,
+        symbol_opening_curly_brace,
+        symbol_closing_curly_brace,
+        symbol_opening_parenthesis,
+        symbol_closing_parenthesis,
+        symbol_comma,
+        symbol_colon,
+        symbol_semicolon,
+        symbol_quotation_mark,
+        symbol_equal_sign,
+        symbol_comparison_sign,
+        symbol_exclamation_mark,
+        symbol_arithmetic_sign,
+        symbol_logical_sign,
+        special_identifier_operation,
+        special_identifier_operand_of_unary_operation,
+        special_identifier_first_operand_of_binary_operation,
+        special_identifier_second_operand_of_binary_operation,
+        special_identifier_v,
+        special_identifier_no,
+        special_identifier_real,
+        special_identifier_solution,
+        special_identifier_modulus,
+        special_identifier_square_of_number,
+        special_identifier_square_root_of_number,
+        variable_edge,
+        variable_identifier,
+        variable_integer,
+        variable_variable,
+        operation_logical,
+        operation_arithmetic,
+        operation_operation,
+        string_string,
+        string_beginning,
+        string_logical,
+        string_arithmetic,
+        string_arithmetic_no_real_solution,
+        string_inner_operation,
+        string_inner_first_operand_of_binary_operation,
+        string_inner_second_operand_of_binary_operation,
+        string_inner_operand_binary,
+        string_inner_operand_unary,
+        string_inner_operand_variable,
+        string_inner_operand,
+        string_inner_inner,
+    };
+
+    // [язык][MessageId]
+    inline constexpr std::string_view texts[][messages_count] = {
+        { // en
+            "String",
+            "Position",
+            "Result",
+            "✓ No errors",
+            "☓ There are errors",
+            "Error: invalid character sequence",
+            "Error: invalid character sequence",
+            "Error: invalid character sequence",
+            "Error: invalid character sequence",
+            "Error: invalid character sequence",
+            "Error: invalid character sequence",
+            "Error: invalid character sequence",
+            "Error: invalid character sequence",
+            "Error: invalid character sequence",
+            "Error: invalid character sequence",
+            "Error: invalid character sequence",
+            "Error: invalid character sequence",
+            "Error: invalid character sequence",
+            "Error: invalid keyword (operation: 'op')",
+            "Error: invalid keyword (operand of unary operation: 'od')",
+            "Error: invalid keyword (first operand of binary operation: 'fO')",
+            "Error: invalid keyword (second operand of binary operation: 'sO')",
+            "Error: invalid keyword (v: 'v')",
+            "Error: invalid keyword (no: 'no')",
+            "Error: invalid keyword (real: 'real')",
+            "Error: invalid keyword (solution: 'solution')",
+            "Error: invalid keyword (modulus: 'abs')",
+            "Error: invalid keyword (squaring: 'sqr')",
+            "Error: invalid keyword (taking the square root: 'sqrt')",
+            "Error: invalid form of edge (edge examples: 'A(1,2)': 'A(1)')",
+            "Error: invalid form of identifier",
+            "Error: invalid form of integer",
+            "Error: invalid form of variable",
+            "Error: invalid form of logical operation",
+            "Error: invalid form of arithmetic operation",
+            "Error: invalid form of operation",
+            "Error: invalid structure of string",
+            "Error: invalid start of string beginning",
+            "Error: invalid structure of logical part of string",
+            "Error: invalid structure of arithmetic part of string",
+            "Error: invalid form of 'no real solution'",
+            "Error: invalid form of operation in string",
+            "Error: invalid form of first operand of binary operation in string",
+            "Error: invalid form of second operand of binary operation in string",
+            "Error: invalid form of operand of binary operation in string",
+            "Error: invalid form of operand of unary operation in string",
+            "Error: invalid form of operand in string",
+            "Error: invalid form of operand in string",
+            "Error: invalid form of inner part of string",
+        },
+        { // ru
+            "Строка",
+            "Позиция",
+            "Результат",
+            "✓ Нет ошибок",
+            "☓ Есть ошибки",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверная последовательность символов",
+            "Ошибка: неверное ключевое слово (операция: 'op')",
+            "Ошибка: неверное ключевое слово (операнд унарной операции: 'od')",
+            "Ошибка: неверное ключевое слово (первый операнд бинарной операции: 'f_o')",
+            "Ошибка: неверное ключевое слово (второй операнд бинарной операции: 's_o')",
+            "Ошибка: неверное ключевое слово (значение: 'v')",
+            "Ошибка: неверное ключевое слово (нет: 'no')",
+            "Ошибка: неверное ключевое слово (реальный: 'real')",
+            "Ошибка: неверное ключевое слово (решение: 'solution')",
+            "Ошибка: неверное ключевое слово (модуль: 'abs')",
+            "Ошибка: неверное ключевое слово (квадрат числа: 'sqr')",
+            "Ошибка: неверное ключевое слово (квадратный корень числа: 'sqrt')",
+            "Ошибка: неверный формат грани (примеры граней: '_a(1,2)': '_a(1)')",
+            "Ошибка: неверный формат идентификатора (примеры идентификаторов: 'x1': '_r124')",
+            "Ошибка: неверный формат целого числа",
+            "Ошибка: неверный формат переменной (переменная - идентификатор: число или грань)",
+            "Ошибка: неверный формат логической операции",
+            "Ошибка: неверный формат арифметической операции",
+            "Ошибка: неверный формат операции",
+            "Ошибка: неверный формат строки",
+            "Ошибка: неверный формат начала строки",
+            "Ошибка: неверный формат логической части строки",
+            "Ошибка: неверный формат арифметической части строки",
+            "Ошибка: неверный формат арифметической части строки (должно быть: 'no real solution')",
+            "Ошибка: неверный формат операции внутри строки",
+            "Ошибка: неверный формат первого операнда бинарной операции внутри строки",
+            "Ошибка: неверный формат второго операнда бинарной операции внутри строки",
+            "Ошибка: неверный формат операнда бинарной операции внутри строки",
+            "Ошибка: неверный формат операнда унарной операции внутри строки",
+            "Ошибка: неверный формат операнда внутри строки",
+            "Ошибка: неверный формат операнда внутри строки",
+            "Ошибка: неверный формат внутренней части строки",
+        },
+    };
+
+    // [язык][MessageId]
+    inline constexpr std::wstring_view wtexts[][messages_count] = {
+        { // en
+            L"String",
+            L"Position",
+            L"Result",
+            L"✓ No errors",
+            L"☓ There are errors",
+            L"Error: invalid character sequence",
+            L"Error: invalid character sequence",
+            L"Error: invalid character sequence",
+            L"Error: invalid character sequence",
+            L"Error: invalid character sequence",
+            L"Error: invalid character sequence",
+            L"Error: invalid character sequence",
+            L"Error: invalid character sequence",
+            L"Error: invalid character sequence",
+            L"Error: invalid character sequence",
+            L"Error: invalid character sequence",
+            L"Error: invalid character sequence",
+            L"Error: invalid character sequence",
+            L"Error: invalid keyword (operation: 'op')",
+            L"Error: invalid keyword (operand of unary operation: 'od')",
+            L"Error: invalid keyword (first operand of binary operation: 'fO')",
+            L"Error: invalid keyword (second operand of binary operation: 'sO')",
+            L"Error: invalid keyword (v: 'v')",
+            L"Error: invalid keyword (no: 'no')",
+            L"Error: invalid keyword (real: 'real')",
+            L"Error: invalid keyword (solution: 'solution')",
+            L"Error: invalid keyword (modulus: 'abs')",
+            L"Error: invalid keyword (squaring: 'sqr')",
+            L"Error: invalid keyword (taking the square root: 'sqrt')",
+            L"Error: invalid form of edge (edge examples: 'A(1,2)': 'A(1)')",
+            L"Error: invalid form of identifier",
+            L"Error: invalid form of integer",
+            L"Error: invalid form of variable",
+            L"Error: invalid form of logical operation",
+            L"Error: invalid form of arithmetic operation",
+            L"Error: invalid form of operation",
+            L"Error: invalid structure of string",
+            L"Error: invalid start of string beginning",
+            L"Error: invalid structure of logical part of string",
+            L"Error: invalid structure of arithmetic part of string",
+            L"Error: invalid form of 'no real solution'",
+            L"Error: invalid form of operation in string",
+            L"Error: invalid form of first operand of binary operation in string",
+            L"Error: invalid form of second operand of binary operation in string",
+            L"Error: invalid form of operand of binary operation in string",
+            L"Error: invalid form of operand of unary operation in string",
+            L"Error: invalid form of operand in string",
+            L"Error: invalid form of operand in string",
+            L"Error: invalid form of inner part of string",
+        },
+        { // ru
+            L"Строка",
+            L"Позиция",
+            L"Результат",
+            L"✓ Нет ошибок",
+            L"☓ Есть ошибки",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверная последовательность символов",
+            L"Ошибка: неверное ключевое слово (операция: 'op')",
+            L"Ошибка: неверное ключевое слово (операнд унарной операции: 'od')",
+            L"Ошибка: неверное ключевое слово (первый операнд бинарной операции: 'f_o')",
+            L"Ошибка: неверное ключевое слово (второй операнд бинарной операции: 's_o')",
+            L"Ошибка: неверное ключевое слово (значение: 'v')",
+            L"Ошибка: неверное ключевое слово (нет: 'no')",
+            L"Ошибка: неверное ключевое слово (реальный: 'real')",
+            L"Ошибка: неверное ключевое слово (решение: 'solution')",
+            L"Ошибка: неверное ключевое слово (модуль: 'abs')",
+            L"Ошибка: неверное ключевое слово (квадрат числа: 'sqr')",
+            L"Ошибка: неверное ключевое слово (квадратный корень числа: 'sqrt')",
+            L"Ошибка: неверный формат грани (примеры граней: '_a(1,2)': '_a(1)')",
+            L"Ошибка: неверный формат идентификатора (примеры идентификаторов: 'x1': '_r124')",
+            L"Ошибка: неверный формат целого числа",
+            L"Ошибка: неверный формат переменной (переменная - идентификатор: число или грань)",
+            L"Ошибка: неверный формат логической операции",
+            L"Ошибка: неверный формат арифметической операции",
+            L"Ошибка: неверный формат операции",
+            L"Ошибка: неверный формат строки",
+            L"Ошибка: неверный формат начала строки",
+            L"Ошибка: неверный формат логической части строки",
+            L"Ошибка: неверный формат арифметической части строки",
+            L"Ошибка: неверный формат арифметической части строки (должно быть: 'no real solution')",
+            L"Ошибка: неверный формат операции внутри строки",
+            L"Ошибка: неверный формат первого операнда бинарной операции внутри строки",
+            L"Ошибка: неверный формат второго операнда бинарной операции внутри строки",
+            L"Ошибка: неверный формат операнда бинарной операции внутри строки",
+            L"Ошибка: неверный формат операнда унарной операции внутри строки",
+            L"Ошибка: неверный формат операнда внутри строки",
+            L"Ошибка: неверный формат операнда внутри строки",
+            L"Ошибка: неверный формат внутренней части строки",
+        },
+    };
+
+    static_assert(std::size(pools) == std::size(messages));
+    static_assert(std::size(texts) == std::size(languages));
+    static_assert(std::size(wtexts) == std::size(languages));
+
+    // сообщения TUI (tui_messages.json)
+
+    inline constexpr std::string_view tui_main_menu_messages[] = {
+        "title",
+        "launch",
+        "options",
+        "exit",
+    };
+
+    inline constexpr std::string_view tui_text_menu_messages[] = {
+        "title",
+        "text_source_menu",
+        "text_source_params_menu",
+        "load",
+        "redact",
+        "check",
+        "load_and_check",
+        "save",
+    };
+
+    inline constexpr std::string_view tui_text_source_menu_messages[] = {
+        "title",
+        "db",
+        "file",
+    };
+
+    inline constexpr std::string_view tui_text_db_source_params_menu_messages[] = {
+        "title",
+        "loading_params",
+        "db_connection_params",
+    };
+
+    inline constexpr std::string_view tui_text_file_source_params_menu_messages[] = {
+        "title",
+        "file_params",
+    };
+
+    inline constexpr std::string_view tui_representation_loading_form_messages[] = {
+        "title",
+        "name",
+        "description",
+        "dimensionality",
+        "iterations",
+    };
+
+    inline constexpr std::string_view tui_db_connection_form_messages[] = {
+        "title",
+        "db_name",
+        "db_login",
+        "db_password",
+        "db_host",
+        "db_port",
+    };
+
+    inline constexpr std::string_view tui_file_params_form_messages[] = {
+        "title",
+        "input_file",
+        "output_file",
+    };
+
+    inline constexpr std::string_view tui_options_menu_messages[] = {
+        "title",
+        "check_options",
+        "language_options",
+    };
+
+    inline constexpr std::string_view tui_work_mode_options_menu_messages[] = {
+        "title",
+        "until_first_error",
+        "all_errors",
+        "all_errors_detailed",
+        "exit",
+    };
+
+    inline constexpr std::string_view tui_language_options_menu_messages[] = {
+        "title",
+        "russian",
+        "english",
+        "exit",
+    };
+
+    inline constexpr std::string_view tui_text_edit_window_messages[] = {
+        "title",
+    };
+
+    inline constexpr std::string_view tui_modal_window_success_info_messages[] = {
+        "title",
+        "message",
+        "ok_text",
+    };
+
+    inline constexpr std::string_view tui_modal_window_restart_info_messages[] = {
+        "title",
+        "message",
+        "ok_text",
+    };
+
+    inline constexpr std::string_view tui_modal_window_not_loaded_error_messages[] = {
+        "title",
+        "message",
+        "ok_text",
+    };
+
+    inline constexpr std::string_view tui_modal_window_load_error_messages[] = {
+        "title",
+        "message",
+        "ok_text",
+    };
+
+    inline constexpr std::string_view tui_pools[] = {
+        "main_menu",
+        "text_menu",
+        "text_source_menu",
+        "text_db_source_params_menu",
+        "text_file_source_params_menu",
+        "representation_loading_form",
+        "db_connection_form",
+        "file_params_form",
+        "options_menu",
+        "work_mode_options_menu",
+        "language_options_menu",
+        "text_edit_window",
+        "modal_window_success_info",
+        "modal_window_restart_info",
+        "modal_window_not_loaded_error",
+        "modal_window_load_error",
+    };
+
+    inline constexpr std::span<const std::string_view> tui_messages[] = {
+        tui_main_menu_messages,
+        tui_text_menu_messages,
+        tui_text_source_menu_messages,
+        tui_text_db_source_params_menu_messages,
+        tui_text_file_source_params_menu_messages,
+        tui_representation_loading_form_messages,
+        tui_db_connection_form_messages,
+        tui_file_params_form_messages,
+        tui_options_menu_messages,
+        tui_work_mode_options_menu_messages,
+        tui_language_options_menu_messages,
+        tui_text_edit_window_messages,
+        tui_modal_window_success_info_messages,
+        tui_modal_window_restart_info_messages,
+        tui_modal_window_not_loaded_error_messages,
+        tui_modal_window_load_error_messages,
+    };
+
+    inline constexpr short tui_pool_offsets[] = {
+        0,
+        4,
+        12,
+        15,
+        18,
+        20,
+        25,
+        31,
+        34,
+        37,
+        42,
+        46,
+        47,
+        50,
+        53,
+        56,
+    };
+
+    inline constexpr size_t tui_messages_count = 59;
+
+    enum class TuiMessageId : short {
+        main_menu_title,
+        main_menu_launch,
+        main_menu_options,
+        main_menu_exit,
+        text_menu_title,
+        text_menu_text_source_menu,
+        text_menu_text_source_params_menu,
+        text_menu_load,
+        text_menu_redact,
+        text_menu_check,
+        text_menu_load_and_check,
+        text_menu_save,
+        text_source_menu_title,
+        text_source_menu_db,
+        text_source_menu_file,
+        text_db_source_params_menu_title,
+        text_db_source_params_menu_loading_params,
+        text_db_source_params_menu_db_connection_params,
+        text_file_source_params_menu_title,
+        text_file_source_params_menu_file_params,
+        representation_loading_form_title,
+        representation_loading_form_name,
+        representation_loading_form_description,
+        representation_loading_form_dimensionality,
+        representation_loading_form_iterations,
+        db_connection_form_title,
+        db_connection_form_db_name,
+        db_connection_form_db_login,
+        db_connection_form_db_password,
+        db_connection_form_db_host,
+        db_connection_form_db_port,
+        file_params_form_title,
+        file_params_form_input_file,
+        file_params_form_output_file,
+        options_menu_title,
+        options_menu_check_options,
+        options_menu_language_options,
+        work_mode_options_menu_title,
+        work_mode_options_menu_until_first_error,
+        work_mode_options_menu_all_errors,
+        work_mode_options_menu_all_errors_detailed,
+        work_mode_options_menu_exit,
+        language_options_menu_title,
+        language_options_menu_russian,
+        language_options_menu_english,
+        language_options_menu_exit,
+        text_edit_window_title,
+        modal_window_success_info_title,
+        modal_window_success_info_message,
+        modal_window_success_info_ok_text,
+        modal_window_restart_info_title,
+        modal_window_restart_info_message,
+        modal_window_restart_info_ok_text,
+        modal_window_not_loaded_error_title,
+        modal_window_not_loaded_error_message,
+        modal_window_not_loaded_error_ok_text,
+        modal_window_load_error_title,
+        modal_window_load_error_message,
+        modal_window_load_error_ok_text,
+    };
+
+    // [язык][TuiMessageId]
+    inline constexpr std::string_view tui_texts[][tui_messages_count] = {
+        { // en
+            "Main menu",
+            "Start",
+            "Options",
+            "Exit",
+            "Work with text",
+            "Source",
+            "Source parameters",
+            "Load",
+            "Redact",
+            "Check",
+            "Load and check",
+            "Save",
+            "Source",
+            "Database",
+            "File",
+            "Source parameters (DB)",
+            "Loading parameters",
+            "DB connection parameters",
+            "Loading parameters (file)",
+            "File parameters",
+            "Loading parameters",
+            "Name:",
+            "Description:",
+            "Dimensionality:",
+            "Iterations:",
+            "DB connection parameters",
+            "DB name:",
+            "Login:",
+            "Password:",
+            "Host:",
+            "Port:",
+            "Loading parameters",
+            "Input file:",
+            "Output file:",
+            "Options",
+            "Check settings",
+            "Language selection",
+            "Check settings",
+            "Until first error",
+            "All errors",
+            "All errors (detailed)",
+            "Back",
+            "Language selection",
+            "Russian",
+            "English",
+            "Back",
+            "Text editor",
+            "Notification",
+            "Operation completed successfully.",
+            "OK",
+            "Notification",
+            "Restart the program to make the changes take effect.",
+            "OK",
+            "Error",
+            "The view is not yet loaded.",
+            "OK",
+            "Error",
+            "Couldn't load the view. Check its attributes or database connection settings (or file path).",
+            "OK",
+        },
+        { // ru
+            "Главное меню",
+            "Начать",
+            "Настройки",
+            "Выход",
+            "Работа с текстом",
+            "Источник",
+            "Параметры источника",
+            "Загрузить",
+            "Редактировать",
+            "Проверить",
+            "Загрузить и проверить",
+            "Сохранить",
+            "Источник",
+            "База данных",
+            "Файл",
+            "Параметры источника (БД)",
+            "Параметры загрузки",
+            "Подключение к БД",
+            "Параметры загрузки (файл)",
+            "Параметры загрузки",
+            "Параметры загрузки",
+            "Название:",
+            "Описание:",
+            "Размерность:",
+            "Итерации:",
+            "Параметры подключения",
+            "Имя БД:",
+            "Логин:",
+            "Пароль:",
+            "Хост:",
+            "Порт:",
+            "Параметры загрузки",
+            "Входной файл:",
+            "Выходной файл:",
+            "Настройки",
+            "Настройки проверки",
+            "Выбор языка",
+            "Настройки режима работы",
+            "До первой ошибки",
+            "Все ошибки",
+            "Все ошибки (подробно)",
+            "Назад",
+            "Выбор языка",
+            "Русский",
+            "Английский",
+            "Назад",
+            "Редактирование текста",
+            "Оповещение",
+            "Операция успешна.",
+            "ОК",
+            "Оповещение",
+            "Перезапустите приложение, чтобы изменения вступили в силу.",
+            "ОК",
+            "Ошибка",
+            "Представление еще не загружено.",
+            "ОК",
+            "Ошибка",
+            "Не удалось загрузить представление. Проверьте его атрибуты или настройки подключения к базе данных (или путь к файлу).",
+            "OK",
+        },
+    };
+
+    // [язык][TuiMessageId]
+    inline constexpr std::wstring_view tui_wtexts[][tui_messages_count] = {
+        { // en
+            L"Main menu",
+            L"Start",
+            L"Options",
+            L"Exit",
+            L"Work with text",
+            L"Source",
+            L"Source parameters",
+            L"Load",
+            L"Redact",
+            L"Check",
+            L"Load and check",
+            L"Save",
+            L"Source",
+            L"Database",
+            L"File",
+            L"Source parameters (DB)",
+            L"Loading parameters",
+            L"DB connection parameters",
+            L"Loading parameters (file)",
+            L"File parameters",
+            L"Loading parameters",
+            L"Name:",
+            L"Description:",
+            L"Dimensionality:",
+            L"Iterations:",
+            L"DB connection parameters",
+            L"DB name:",
+            L"Login:",
+            L"Password:",
+            L"Host:",
+            L"Port:",
+            L"Loading parameters",
+            L"Input file:",
+            L"Output file:",
+            L"Options",
+            L"Check settings",
+            L"Language selection",
+            L"Check settings",
+            L"Until first error",
+            L"All errors",
+            L"All errors (detailed)",
+            L"Back",
+            L"Language selection",
+            L"Russian",
+            L"English",
+            L"Back",
+            L"Text editor",
+            L"Notification",
+            L"Operation completed successfully.",
+            L"OK",
+            L"Notification",
+            L"Restart the program to make the changes take effect.",
+            L"OK",
+            L"Error",
+            L"The view is not yet loaded.",
+            L"OK",
+            L"Error",
+            L"Couldn't load the view. Check its attributes or database connection settings (or file path).",
+            L"OK",
+        },
+        { // ru
+            L"Главное меню",
+            L"Начать",
+            L"Настройки",
+            L"Выход",
+            L"Работа с текстом",
+            L"Источник",
+            L"Параметры источника",
+            L"Загрузить",
+            L"Редактировать",
+            L"Проверить",
+            L"Загрузить и проверить",
+            L"Сохранить",
+            L"Источник",
+            L"База данных",
+            L"Файл",
+            L"Параметры источника (БД)",
+            L"Параметры загрузки",
+            L"Подключение к БД",
+            L"Параметры загрузки (файл)",
+            L"Параметры загрузки",
+            L"Параметры загрузки",
+            L"Название:",
+            L"Описание:",
+            L"Размерность:",
+            L"Итерации:",
+            L"Параметры подключения",
+            L"Имя БД:",
+            L"Логин:",
+            L"Пароль:",
+            L"Хост:",
+            L"Порт:",
+            L"Параметры загрузки",
+            L"Входной файл:",
+            L"Выходной файл:",
+            L"Настройки",
+            L"Настройки проверки",
+            L"Выбор языка",
+            L"Настройки режима работы",
+            L"До первой ошибки",
+            L"Все ошибки",
+            L"Все ошибки (подробно)",
+            L"Назад",
+            L"Выбор языка",
+            L"Русский",
+            L"Английский",
+            L"Назад",
+            L"Редактирование текста",
+            L"Оповещение",
+            L"Операция успешна.",
+            L"ОК",
+            L"Оповещение",
+            L"Перезапустите приложение, чтобы изменения вступили в силу.",
+            L"ОК",
+            L"Ошибка",
+            L"Представление еще не загружено.",
+            L"ОК",
+            L"Ошибка",
+            L"Не удалось загрузить представление. Проверьте его атрибуты или настройки подключения к базе данных (или путь к файлу).",
+            L"OK",
+        },
+    };
+
+    static_assert(std::size(tui_pools) == std::size(tui_messages));
+    static_assert(std::size(tui_texts) == std::size(languages));
+    static_assert(std::size(tui_wtexts) == std::size(languages));
+};
\ No newline at end of file
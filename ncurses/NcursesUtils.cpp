@@ -409,6 +409,23 @@ wchar_t nu::wget_wch(WINDOW* win, WorkMode mode)
 #endif
 }
 
+bool nu::wait_for_input(WINDOW* win, int timeout_ms)
+{
+#ifdef _WIN32
+    return WaitForSingleObject(GetStdHandle(STD_INPUT_HANDLE), timeout_ms) == WAIT_OBJECT_0;
+#else
+    wint_t wch;
+    wtimeout(win, timeout_ms);
+    int status = ::wget_wch(win, &wch);
+    wtimeout(win, -1);
+    if (status == ERR) {
+        return false;
+    }
+    unget_wch(wch);
+    return true;
+#endif
+}
+
 wchar_t nu::get_wch_by_read_console(WorkMode mode)
 {
     HANDLE hIn = GetStdHandle(STD_INPUT_HANDLE);
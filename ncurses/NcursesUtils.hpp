@@ -229,5 +229,7 @@ namespace nu {
 
     wchar_t wget_wch(WINDOW* win, WorkMode mode = WorkMode::Default);
     wchar_t get_wch_by_read_console(WorkMode mode = WorkMode::Default);
+    // ждёт ввод не дольше timeout_ms; введённый символ остаётся непрочитанным
+    bool wait_for_input(WINDOW* win, int timeout_ms);
     void wprint_text(WINDOW* win, TextW title, Size size, Position position);
 }
@@ -4,6 +4,8 @@
 #include <io.h>
 #include <fcntl.h>
 #include <fstream>
+#include <thread>
+#include <atomic>
 #include <windows.h>
 #include <boost/nowide/args.hpp>
 #include <boost/nowide/fstream.hpp>
@@ -70,8 +72,8 @@ struct IRepresentation {
     virtual std::vector<std::string> get_strings() = 0;
     virtual void set_strings(const std::vector<std::string>& strings) = 0;
     virtual void save() = 0;
-    virtual void check() = 0;
-    virtual std::vector<std::string> get_validity(std::string pool_name) = 0;
+    // результаты по строкам публикуются в канал по мере проверки
+    virtual void check(ResultChannel& channel) = 0;
 };
 
 class RepresentationFromFile : public IRepresentation {
@@ -96,17 +98,13 @@ public:
         DataUtils::FileUtils::write_strings_to_file(settings.file_settings.input_file_path, strings);
     }
 
-    void check() override
+    void check(ResultChannel& channel) override
     {
         VerificationSystem v_system = VerificationSystem(settings.global_settings.errors_mode);
+        v_system.set_result_channel(&channel);
         v_system.check_strings(strings, settings.file_settings.output_file_path);
     }
 
-    std::vector<std::string> get_validity(std::string pool_name) override
-    {
-        return DataUtils::FileUtils::read_strings_from_file(settings.file_settings.output_file_path);
-    }
-
 private:
     Settings settings;
     std::vector<std::string> strings;
@@ -116,32 +114,13 @@ class RepresentationFromDB : public IRepresentation {
 public:
     RepresentationFromDB(Settings settings) : settings(settings)
     {
-        SharedRepository::get_instance().connect(settings.db_settings.db_connection);
-        auto algorithm_representations = SharedRepository::get_instance()
-            .get_algorithm_representation_repository()
-            .get_by_field("name", settings.db_settings.algorithm_name);
-        
-        if (algorithm_representations.size() == 0) {
-            throw std::runtime_error("Algorithm not found by name");
-        }
-
-        // фильтруем по описанию, размерности и итерациям
-        std::vector<AlgorithmRepresentation> filtered_algorithm_representations;
-        for (AlgorithmRepresentation algorithm_representation : algorithm_representations) {
-            std::string current_lang = settings.global_settings.language == Language::Type::English ? "en" : "ru";
-            if (!algorithm_representation.algorithm.description[current_lang].empty() &&
-                    algorithm_representation.algorithm.description[current_lang] != "-" &&
-                    algorithm_representation.algorithm.description[current_lang] != settings.db_settings.algorithm_description) {
-                continue;
-            }
-            if (algorithm_representation.representation.dimensionality != settings.db_settings.dimensionality) {
-                continue;
-            }
-            if (algorithm_representation.representation.iterations != settings.db_settings.iterations) {
-                continue;
-            }
-            filtered_algorithm_representations.push_back(algorithm_representation);
+        if (!settings.db_settings.snapshot_cache_directory.empty()) {
+            SharedRepository::get_instance().enable_snapshot_cache(settings.db_settings.snapshot_cache_directory);
         }
+        SharedRepository::get_instance().open(settings.db_settings.storage, settings.db_settings.db_connection, settings.db_settings.storage_directory);
+        auto filtered_algorithm_representations = SharedRepository::get_instance()
+            .get_algorithm_representation_repository()
+            .get_by_filter(settings.make_representation_filter());
 
         if (filtered_algorithm_representations.size() == 0) {
             throw std::runtime_error("Algorithm not found");
@@ -172,45 +151,93 @@ public:
     void save() override
     {
         SharedRepository::get_instance().get_algorithm_representation_repository().update(representation);
+        representation.mark_clean();
     }
 
-    void check() override
+    void check(ResultChannel& channel) override
     {
         VerificationSystem v_system = VerificationSystem(settings.global_settings.errors_mode);
+        v_system.set_result_channel(&channel);
         v_system.check_db_representation(representation);
     }
 
-    std::vector<std::string> get_validity(std::string pool_name) override
+private:
+    Settings settings;
+    AlgorithmRepresentation representation;
+};
+
+// проверка представления в фоновом потоке: результаты приходят через ResultChannel
+// и выводятся в порядке номеров строк, как только готов очередной непрерывный участок
+class RepresentationCheck {
+public:
+    RepresentationCheck(std::shared_ptr<IRepresentation> representation)
+        : channel(std::make_shared<ResultChannel>(make_channel_name(), ResultChannel::default_capacity)),
+          error(std::make_shared<std::exception_ptr>())
     {
-        auto current_pool = SharedRepository::get_instance().get_message_storage().get_current_pool();
-        std::vector<std::string> validity;
-        for (int i = 0; i < (int)representation.representation_strings.size(); i++) {
-            if (representation.representation_strings[i].validity.has_value()) {
-                std::string str = representation.representation_strings[i].validity.value()[pool_name];
-                // делаем split через std::ranges
-                auto buf = str
-                    | std::ranges::views::split('\n')
-                    | std::ranges::to<std::vector<std::string>>();
-                auto string_message = current_pool["other"]["string"];
-                string_message += ": " + std::to_string(i + 1) + "\n";
-                validity.push_back(string_message);
-
-                for (auto it = buf.begin(); it != buf.end(); it++) {
-                    validity.push_back("\t" + *it);
-                }
+        thread = std::thread([representation, channel = this->channel, error = this->error]() {
+            try {
+                representation->check(*channel);
             }
-            else {
-                auto string_message = current_pool["other"]["string"];
-                string_message += ": " + std::to_string(i + 1) + "\n";
-                validity.push_back(string_message);
+            catch (...) {
+                *error = std::current_exception();
             }
+            channel->finish();
+        });
+    }
+
+    ~RepresentationCheck()
+    {
+        channel->cancel();
+        thread.join();
+    }
+
+    RepresentationCheck(const RepresentationCheck&) = delete;
+    RepresentationCheck& operator=(const RepresentationCheck&) = delete;
+
+    // забирает готовые результаты и возвращает строки отчёта, которые можно дописать в окно;
+    // false в is_running — проверка завершена и всё выведено
+    std::vector<std::string> poll(bool& is_running)
+    {
+        std::vector<std::string> lines;
+        while (auto string_result = channel->try_consume()) {
+            int string_index = string_result->string_index;
+            if (string_index >= (int)pending.size()) {
+                pending.resize(string_index + 1);
+            }
+            pending[string_index] = std::move(string_result);
         }
-        return validity;
+
+        Debugger debugger = Debugger();
+        while (next_index < (int)pending.size() && pending[next_index].has_value()) {
+            if (next_index != 0) {
+                lines.push_back("");
+            }
+            auto string_lines = debugger.get_message_and_result(next_index, pending[next_index]->messages, pending[next_index]->result);
+            lines.insert(lines.end(), string_lines.begin(), string_lines.end());
+            pending[next_index].reset();
+            next_index++;
+        }
+
+        is_running = !channel->is_finished() || next_index < (int)channel->get_strings_count();
+        if (channel->is_finished() && *error) {
+            is_running = false;
+            std::rethrow_exception(*error);
+        }
+        return lines;
     }
 
 private:
-    Settings settings;
-    AlgorithmRepresentation representation;
+    std::shared_ptr<ResultChannel> channel;
+    std::shared_ptr<std::exception_ptr> error;
+    std::thread thread;
+    std::vector<std::optional<StringResult>> pending;
+    int next_index = 0;
+
+    static std::string make_channel_name()
+    {
+        static std::atomic<int> channels_count = 0;
+        return "qd_tui_results_" + std::to_string(GetCurrentProcessId()) + "_" + std::to_string(channels_count++);
+    }
 };
 
 void init(Settings settings)
@@ -229,6 +256,11 @@ void init(Settings settings)
     }
 
     MenuSharedRepository::get_instance().connect();
+
+    if (!settings.global_settings.messages_override_file_path.empty()) {
+        SharedRepository::get_instance().load_message_overrides(settings.global_settings.messages_override_file_path);
+        MenuSharedRepository::get_instance().load_message_overrides(settings.global_settings.messages_override_file_path);
+    }
 }
 
 int main(int argc, char* argv[]) {
@@ -247,6 +279,7 @@ int main(int argc, char* argv[]) {
     auto& current_pool = message_storage.get_current_pool();
 
     std::shared_ptr<IRepresentation> representation { nullptr };
+    std::unique_ptr<RepresentationCheck> representation_check { nullptr };
 
     nu::init(nu::Default);
 
@@ -331,6 +364,8 @@ int main(int argc, char* argv[]) {
         if (representation && text_edit_win_representation_loaded) {
             representation->set_strings(text_edit_win->get_lines());
         }
+        // фоновая проверка не должна пересекаться с редактированием и сохранением представления
+        representation_check.reset();
     };
 
     auto main_menu_size = Size(10, 16);
@@ -371,6 +406,29 @@ int main(int argc, char* argv[]) {
     text_menu_win->set_active_items_attrs(COLOR_PAIR(nu::Green));
     text_menu_win->set_unfocused_items_attrs(COLOR_PAIR(nu::Green) | A_REVERSE);
     text_menu_win->set_menu_margins(1, 0, 1, 1);
+    // результаты проверки дописываются в окно по мере поступления из фонового потока
+    auto check_representation = [&]() {
+        representation_check.reset();
+        representation_check = std::make_unique<RepresentationCheck>(representation);
+        text_edit_win_representation_loaded = false;
+        text_edit_win->load({});
+        text_edit_win->show();
+        text_edit_win->run_non_editable([&]() {
+            if (!representation_check) {
+                return false;
+            }
+            try {
+                bool is_running = true;
+                text_edit_win->append(representation_check->poll(is_running));
+                return is_running;
+            }
+            catch (const std::exception& e) {
+                modal_win_load_error->show();
+                modal_win_load_error->run();
+                return false;
+            }
+        });
+    };
     text_menu_win->add_menu_item(current_pool["text_menu"]["text_source_menu"], L"", [&]() {
         text_menu_win->stop();
         text_source_menu_win->show();
@@ -426,11 +484,7 @@ int main(int argc, char* argv[]) {
     text_menu_win->add_menu_item(current_pool["text_menu"]["check"], L"", [&]() {
         try {
             if (representation) {
-                representation->check();
-                text_edit_win_representation_loaded = false;
-                text_edit_win->load(representation->get_validity(message_storage.get_current_pool_name()));
-                text_edit_win->show();
-                text_edit_win->run_non_editable();
+                check_representation();
             }
             else {
                 modal_win_not_loaded_error->show();
@@ -454,11 +508,7 @@ int main(int argc, char* argv[]) {
                     break;
             }
 
-            representation->check();
-            text_edit_win_representation_loaded = false;
-            text_edit_win->load(representation->get_validity(message_storage.get_current_pool_name()));
-            text_edit_win->show();
-            text_edit_win->run_non_editable();
+            check_representation();
         }
         catch (const std::exception& e) {
             modal_win_load_error->show();
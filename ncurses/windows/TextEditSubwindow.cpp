@@ -65,6 +65,22 @@ void TextEditSubwindow::load(const std::vector<std::string>& input_lines)
     first_visible_line = first_visible_col = 0;
 }
 
+void TextEditSubwindow::append(const std::vector<std::string>& input_lines)
+{
+    if (input_lines.empty()) {
+        return;
+    }
+
+    // пустой буфер после load({}) содержит одну пустую строку
+    if (lines.size() == 1 && lines.front().empty()) {
+        lines.clear();
+    }
+    lines.reserve(lines.size() + input_lines.size());
+    std::transform(input_lines.begin(), input_lines.end(), std::back_inserter(lines), nu::string_to_wstring);
+
+    line_number_width = std::to_wstring(lines.size()).length();
+}
+
 std::vector<std::string> TextEditSubwindow::get_lines() const
 {
     std::vector<std::string> output;
@@ -545,7 +561,7 @@ void TextEditSubwindow::run()
     }
 }
 
-void TextEditSubwindow::run_non_editable()
+void TextEditSubwindow::run_non_editable(IdleCallback on_idle)
 {
     if (!win) {
         throw std::runtime_error("FormWindow::run(): form_window is nullptr");
@@ -562,6 +578,15 @@ void TextEditSubwindow::run_non_editable()
             return;
         }
 
+        // пока данные поступают, ввод ожидается с таймаутом и окно перерисовывается
+        if (on_idle && !nu::wait_for_input(win.get(), idle_timeout_ms)) {
+            if (!on_idle()) {
+                on_idle = nullptr;
+            }
+            draw_content();
+            continue;
+        }
+
         wint_t wch = nu::wget_wch(win.get(), nu::work_mode);
         if (execute_exit_callback(wch) || wch == K_ESCAPE) {
             set_focus(false);
@@ -7,6 +7,8 @@
 class TextEditSubwindow : public BaseWindow, IRunnable {
 public:
     using ptr = std::shared_ptr<TextEditSubwindow>;
+    // вызывается, пока нет ввода; false — новых данных больше не будет
+    using IdleCallback = std::function<bool()>;
 
     static ptr create(BaseWindow::ptr parent, Size size, Position position);
     static ptr create(BaseWindow::ptr parent, unsigned height, unsigned width, 
@@ -27,6 +29,8 @@ public:
     void set_active_border(std::shared_ptr<IBorder> active_border) = delete;
 
     void load(const std::vector<std::string>& lines);
+    // дописывает строки в конец буфера, не сбрасывая курсор и прокрутку
+    void append(const std::vector<std::string>& lines);
     std::vector<std::string> get_lines() const;
 
     void resize(unsigned height, unsigned width) override;
@@ -36,7 +40,7 @@ public:
     void hide() override;
 
     void run() override;
-    void run_non_editable();
+    void run_non_editable(IdleCallback on_idle = nullptr);
     void stop() override;
     bool is_running() override;
 
@@ -82,4 +86,5 @@ private:
     bool need_horizontal_scrollbar_ = false;
     unsigned horizontal_scrollbar_height_ = 0;
     bool is_running_ = false;
+    static inline constexpr int idle_timeout_ms = 100;
 };
\ No newline at end of file
@@ -145,6 +145,13 @@ void TextEditView::load(const std::vector<std::string>& lines)
     }
 }
 
+void TextEditView::append(const std::vector<std::string>& lines)
+{
+    if (text_window) {
+        text_window->append(lines);
+    }
+}
+
 std::vector<std::string> TextEditView::get_lines() const
 {
     return text_window ? text_window->get_lines() : std::vector<std::string>();
@@ -188,9 +195,9 @@ void TextEditView::run()
     text_window->run();
 }
 
-void TextEditView::run_non_editable()
+void TextEditView::run_non_editable(TextEditSubwindow::IdleCallback on_idle)
 {
-    text_window->run_non_editable();
+    text_window->run_non_editable(std::move(on_idle));
 }
 
 void TextEditView::stop()
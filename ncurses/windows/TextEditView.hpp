@@ -35,6 +35,7 @@ public:
     ~TextEditView() override;
 
     void load(const std::vector<std::string>& lines);
+    void append(const std::vector<std::string>& lines);
     std::vector<std::string> get_lines() const;
 
     void resize(unsigned height, unsigned width) override;
@@ -44,7 +45,7 @@ public:
     void hide() override;
 
     void run() override;
-    void run_non_editable();
+    void run_non_editable(TextEditSubwindow::IdleCallback on_idle = nullptr);
     void stop() override;
     bool is_running() override;
 
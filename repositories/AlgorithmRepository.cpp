@@ -1,7 +1,57 @@
 #include "AlgorithmRepository.hpp"
 
-AlgorithmRepository::AlgorithmRepository() 
-    : connection(nullptr) {}
+namespace AlgorithmStatements {
+    inline constexpr PreparedStatement add { "algorithms_add", R"(
+        INSERT INTO algorithms_data (name, description)
+        VALUES ($1::jsonb, $2::jsonb);
+    )" };
+    inline constexpr PreparedStatement update { "algorithms_update", R"(
+        UPDATE algorithms_data
+        SET name = $1::jsonb, description = $2::jsonb
+        WHERE algorithm_id = $3;
+    )" };
+    inline constexpr PreparedStatement update_name { "algorithms_update_name", R"(
+        UPDATE algorithms_data
+        SET name = $1::jsonb
+        WHERE algorithm_id = $2;
+    )" };
+    inline constexpr PreparedStatement update_description { "algorithms_update_description", R"(
+        UPDATE algorithms_data
+        SET description = $1::jsonb
+        WHERE algorithm_id = $2;
+    )" };
+    inline constexpr PreparedStatement remove { "algorithms_remove", R"(
+        DELETE FROM algorithms_data
+        WHERE algorithm_id = $1;
+    )" };
+    inline constexpr PreparedStatement get_all { "algorithms_get_all", R"(
+        SELECT * FROM algorithms_data;
+    )" };
+    inline constexpr PreparedStatement get_by_id { "algorithms_get_by_id", R"(
+        SELECT * FROM algorithms_data
+        WHERE algorithm_id = $1;
+    )" };
+    // слова ищутся в названии или описании на языке сессии (main.lang()), как и раньше;
+    // условие по обоим языкам совпадает с выражением триграммных индексов sql/migrations/001_search_indexes.sql
+    // и без миграции лишь повторяет проверку
+    inline constexpr PreparedStatement get_by_name { "algorithms_get_by_name", R"(
+        SELECT * FROM algorithms_data
+        WHERE (coalesce(name->>'en', '') || ' ' || coalesce(name->>'ru', '')) ILIKE ALL($1::text[])
+            AND name->>main.lang() ILIKE ALL($1::text[]);
+    )" };
+    inline constexpr PreparedStatement get_by_description { "algorithms_get_by_description", R"(
+        SELECT * FROM algorithms_data
+        WHERE (coalesce(description->>'en', '') || ' ' || coalesce(description->>'ru', '')) ILIKE ALL($1::text[])
+            AND description->>main.lang() ILIKE ALL($1::text[]);
+    )" };
+
+    inline constexpr PreparedStatement all[] = {
+        add, update, update_name, update_description, remove, get_all, get_by_id, get_by_name, get_by_description,
+    };
+};
+
+AlgorithmRepository::AlgorithmRepository()
+    : connection(nullptr), owns_connection(false) {}
 
 AlgorithmRepository::~AlgorithmRepository() {
     disconnect();
@@ -10,41 +60,52 @@ AlgorithmRepository::~AlgorithmRepository() {
 void AlgorithmRepository::connect(std::string connection)
 {
     this->connection = new pqxx::connection(connection);
+    this->owns_connection = true;
+    PreparedStatements::prepare(*this->connection, AlgorithmStatements::all);
 }
 
 void AlgorithmRepository::connect(pqxx::connection* connection)
 {
     this->connection = connection;
+    this->owns_connection = false;
+    PreparedStatements::prepare(*this->connection, AlgorithmStatements::all);
 }
 
 void AlgorithmRepository::disconnect()
 {
     if (connection == nullptr) return;
 
-    delete connection;
+    if (owns_connection) {
+        delete connection;
+    }
     connection = nullptr;
+    owns_connection = false;
 }
 
 void AlgorithmRepository::add(AlgorithmDTO object)
 {
     pqxx::work tx(*connection);
 
-    tx.exec(R"(
-        INSERT INTO algorithms_data (name, description)
-        VALUES ($1::jsonb, $2::jsonb);
-    )", pqxx::params{object.name.dump(), object.description.dump()});
+    tx.exec(pqxx::prepped{AlgorithmStatements::add.name}, pqxx::params{object.name.dump(), object.description.dump()});
     tx.commit();
 }
 
 void AlgorithmRepository::update(AlgorithmDTO object)
 {
+    // записываются только поля, изменённые с момента загрузки
+    if (!object.is_dirty()) return;
+
     pqxx::work tx(*connection);
 
-    tx.exec(R"(
-        UPDATE algorithms_data
-        SET name = $1::jsonb, description = $2::jsonb
-        WHERE algorithm_id = $3;
-    )", pqxx::params{object.name.dump(), object.description.dump(), object.algorithm_id});
+    if (object.is_name_dirty() && object.is_description_dirty()) {
+        tx.exec(pqxx::prepped{AlgorithmStatements::update.name}, pqxx::params{object.name.dump(), object.description.dump(), object.algorithm_id});
+    }
+    else if (object.is_name_dirty()) {
+        tx.exec(pqxx::prepped{AlgorithmStatements::update_name.name}, pqxx::params{object.name.dump(), object.algorithm_id});
+    }
+    else {
+        tx.exec(pqxx::prepped{AlgorithmStatements::update_description.name}, pqxx::params{object.description.dump(), object.algorithm_id});
+    }
     tx.commit();
 }
 
@@ -52,10 +113,7 @@ void AlgorithmRepository::remove(AlgorithmDTO object)
 {
     pqxx::work tx(*connection);
 
-    tx.exec(R"(
-        DELETE FROM algorithms_data
-        WHERE algorithm_id = $1;
-    )", pqxx::params{object.algorithm_id});
+    tx.exec(pqxx::prepped{AlgorithmStatements::remove.name}, pqxx::params{object.algorithm_id});
     tx.commit();
 }
 
@@ -63,16 +121,16 @@ std::vector<AlgorithmDTO> AlgorithmRepository::get_all()
 {
     pqxx::work tx(*connection);
 
-    pqxx::result rows = tx.exec(R"(
-        SELECT * FROM algorithms_data;
-    )");
+    pqxx::result rows = tx.exec(pqxx::prepped{AlgorithmStatements::get_all.name});
 
     std::vector<AlgorithmDTO> algorithms_data;
     algorithms_data.reserve(rows.size());
 
     for (const auto& row : rows) {
         auto [algorithm_id, name, description] = row.as<int, std::string, std::string>();
-        algorithms_data.push_back(AlgorithmDTO(algorithm_id, json::parse(name), json::parse(description)));
+        AlgorithmDTO algorithm(algorithm_id, json::parse(name), json::parse(description));
+        algorithm.mark_clean();
+        algorithms_data.push_back(algorithm);
     }
 
     return algorithms_data;
@@ -82,34 +140,45 @@ std::optional<AlgorithmDTO> AlgorithmRepository::get_by_id(int id)
 {
     pqxx::work tx(*connection);
 
-    pqxx::result rows = tx.exec(R"(
-        SELECT * FROM algorithms_data
-        WHERE algorithm_id = $1;
-    )", pqxx::params{id});
+    pqxx::result rows = tx.exec(pqxx::prepped{AlgorithmStatements::get_by_id.name}, pqxx::params{id});
 
     if (rows.empty()) return std::nullopt;
 
     auto [algorithm_id, name, description] = rows.front().as<int, std::string, std::string>();
-    return AlgorithmDTO(algorithm_id, json::parse(name), json::parse(description));
+    AlgorithmDTO algorithm(algorithm_id, json::parse(name), json::parse(description));
+    algorithm.mark_clean();
+    return algorithm;
 }
 
 std::vector<AlgorithmDTO> AlgorithmRepository::get_by_field(const std::string& field, const std::string& value)
 {
     pqxx::work tx(*connection);
 
-    auto regex = make_regex_by_words(value);
-    pqxx::result rows = tx.exec(R"(
-        SELECT * FROM algorithms_data
-        WHERE $1 ~ $2;
-    )", pqxx::params{field, regex});
+    pqxx::result rows;
+    if (field == "algorithm_id") {
+        auto algorithm_id = parse_integer_field_value(value);
+        if (!algorithm_id.has_value()) return {};
+        rows = tx.exec(pqxx::prepped{AlgorithmStatements::get_by_id.name}, pqxx::params{algorithm_id.value()});
+    }
+    else if (field == "name" || field == "description") {
+        auto patterns = make_like_patterns_by_words(value);
+        const char* statement_name = field == "name" ? AlgorithmStatements::get_by_name.name
+            : AlgorithmStatements::get_by_description.name;
+        rows = tx.exec(pqxx::prepped{statement_name}, pqxx::params{std::move(patterns)});
+    }
+    else {
+        return {};
+    }
 
     std::vector<AlgorithmDTO> algorithms_data;
     algorithms_data.reserve(rows.size());
 
     for (const auto& row : rows) {
         auto [algorithm_id, name, description] = row.as<int, std::string, std::string>();
-        algorithms_data.push_back(AlgorithmDTO(algorithm_id, json::parse(name), json::parse(description)));
+        AlgorithmDTO algorithm(algorithm_id, json::parse(name), json::parse(description));
+        algorithm.mark_clean();
+        algorithms_data.push_back(algorithm);
     }
 
     return algorithms_data;
-}
+}
\ No newline at end of file
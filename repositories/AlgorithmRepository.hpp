@@ -5,6 +5,7 @@
 #include <pqxx/pqxx>
 
 #include "IRepository.hpp"
+#include "PreparedStatements.hpp"
 #include "../dto/AlgorithmDTO.hpp"
 
 class AlgorithmRepository : public IRepository<AlgorithmDTO> {
@@ -26,4 +27,6 @@ public:
 
 private:
     pqxx::connection *connection;
+    // соединение, созданное в connect(std::string), закрывается в disconnect(); переданное извне — нет
+    bool owns_connection;
 };
\ No newline at end of file
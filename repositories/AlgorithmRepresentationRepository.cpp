@@ -1,11 +1,199 @@
 #include "AlgorithmRepresentationRepository.hpp"
 
+namespace AlgorithmRepresentationStatements {
+    inline constexpr PreparedStatement get_by_id { "algorithm_representations_get_by_id", R"(
+        SELECT
+            ad.algorithm_id AS algorithm_id,
+            ad.name AS name,
+            ad.description AS description,
+            rd.representation_id AS representation_id,
+            rd.dimensionality AS dimensionality,
+            rd.iterations AS iterations
+        FROM main.algorithms_data ad
+        JOIN main.representations_data rd
+            ON ad.algorithm_id = rd.algorithm_id
+        WHERE rd.representation_id = $1;
+    )" };
+
+    // слова названия ищутся на языке сессии (main.lang()); условие по обоим языкам повторяет выражение
+    // триграммного индекса (sql/migrations/001_search_indexes.sql), чтобы с миграцией не сканировать таблицу целиком.
+    // пустое описание (NULL) или "-" подходит к любому запрошенному описанию;
+    // как и в get_by_field(), представления без строк не возвращаются
+    inline constexpr PreparedStatement get_by_filter { "algorithm_representations_get_by_filter", R"(
+        SELECT
+            ad.algorithm_id AS algorithm_id,
+            ad.name AS name,
+            ad.description AS description,
+            rd.representation_id AS representation_id,
+            rd.dimensionality AS dimensionality,
+            rd.iterations AS iterations
+        FROM main.algorithms_data ad
+        JOIN main.representations_data rd
+            ON ad.algorithm_id = rd.algorithm_id
+        WHERE (coalesce(ad.name->>'en', '') || ' ' || coalesce(ad.name->>'ru', '')) ILIKE ALL($1::text[])
+            AND ad.name->>main.lang() ILIKE ALL($1::text[])
+            AND (ad.description->>$2 IS NULL OR ad.description->>$2 = '-' OR ad.description->>$2 = $3)
+            AND rd.dimensionality = $4::int[]
+            AND rd.iterations = $5
+            AND EXISTS (
+                SELECT 1 FROM main.representation_strings_data rsd
+                WHERE rsd.representation_id = rd.representation_id
+            )
+        ORDER BY rd.representation_id;
+    )" };
+    inline constexpr PreparedStatement get_ids_by_filter { "algorithm_representations_get_ids_by_filter", R"(
+        SELECT rd.representation_id AS representation_id
+        FROM main.algorithms_data ad
+        JOIN main.representations_data rd
+            ON ad.algorithm_id = rd.algorithm_id
+        WHERE (coalesce(ad.name->>'en', '') || ' ' || coalesce(ad.name->>'ru', '')) ILIKE ALL($1::text[])
+            AND ad.name->>main.lang() ILIKE ALL($1::text[])
+            AND (ad.description->>$2 IS NULL OR ad.description->>$2 = '-' OR ad.description->>$2 = $3)
+            AND rd.dimensionality = $4::int[]
+            AND rd.iterations = $5
+            AND EXISTS (
+                SELECT 1 FROM main.representation_strings_data rsd
+                WHERE rsd.representation_id = rd.representation_id
+            )
+        ORDER BY rd.representation_id;
+    )" };
+
+    // get_by_field(): по одному запросу на каждое допустимое поле; представления без строк не возвращаются
+    inline constexpr PreparedStatement get_by_algorithm_id { "algorithm_representations_get_by_algorithm_id", R"(
+        SELECT
+            ad.algorithm_id AS algorithm_id,
+            ad.name AS name,
+            ad.description AS description,
+            rd.representation_id AS representation_id,
+            rd.dimensionality AS dimensionality,
+            rd.iterations AS iterations
+        FROM main.algorithms_data ad
+        JOIN main.representations_data rd
+            ON ad.algorithm_id = rd.algorithm_id
+        WHERE ad.algorithm_id = $1
+            AND EXISTS (
+                SELECT 1 FROM main.representation_strings_data rsd
+                WHERE rsd.representation_id = rd.representation_id
+            )
+        ORDER BY rd.representation_id;
+    )" };
+    inline constexpr PreparedStatement get_by_name { "algorithm_representations_get_by_name", R"(
+        SELECT
+            ad.algorithm_id AS algorithm_id,
+            ad.name AS name,
+            ad.description AS description,
+            rd.representation_id AS representation_id,
+            rd.dimensionality AS dimensionality,
+            rd.iterations AS iterations
+        FROM main.algorithms_data ad
+        JOIN main.representations_data rd
+            ON ad.algorithm_id = rd.algorithm_id
+        WHERE (coalesce(ad.name->>'en', '') || ' ' || coalesce(ad.name->>'ru', '')) ILIKE ALL($1::text[])
+            AND ad.name->>main.lang() ILIKE ALL($1::text[])
+            AND EXISTS (
+                SELECT 1 FROM main.representation_strings_data rsd
+                WHERE rsd.representation_id = rd.representation_id
+            )
+        ORDER BY rd.representation_id;
+    )" };
+    inline constexpr PreparedStatement get_by_description { "algorithm_representations_get_by_description", R"(
+        SELECT
+            ad.algorithm_id AS algorithm_id,
+            ad.name AS name,
+            ad.description AS description,
+            rd.representation_id AS representation_id,
+            rd.dimensionality AS dimensionality,
+            rd.iterations AS iterations
+        FROM main.algorithms_data ad
+        JOIN main.representations_data rd
+            ON ad.algorithm_id = rd.algorithm_id
+        WHERE (coalesce(ad.description->>'en', '') || ' ' || coalesce(ad.description->>'ru', '')) ILIKE ALL($1::text[])
+            AND ad.description->>main.lang() ILIKE ALL($1::text[])
+            AND EXISTS (
+                SELECT 1 FROM main.representation_strings_data rsd
+                WHERE rsd.representation_id = rd.representation_id
+            )
+        ORDER BY rd.representation_id;
+    )" };
+    inline constexpr PreparedStatement get_by_representation_id { "algorithm_representations_get_by_representation_id", R"(
+        SELECT
+            ad.algorithm_id AS algorithm_id,
+            ad.name AS name,
+            ad.description AS description,
+            rd.representation_id AS representation_id,
+            rd.dimensionality AS dimensionality,
+            rd.iterations AS iterations
+        FROM main.algorithms_data ad
+        JOIN main.representations_data rd
+            ON ad.algorithm_id = rd.algorithm_id
+        WHERE rd.representation_id = $1
+            AND EXISTS (
+                SELECT 1 FROM main.representation_strings_data rsd
+                WHERE rsd.representation_id = rd.representation_id
+            )
+        ORDER BY rd.representation_id;
+    )" };
+    inline constexpr PreparedStatement get_by_dimensionality { "algorithm_representations_get_by_dimensionality", R"(
+        SELECT
+            ad.algorithm_id AS algorithm_id,
+            ad.name AS name,
+            ad.description AS description,
+            rd.representation_id AS representation_id,
+            rd.dimensionality AS dimensionality,
+            rd.iterations AS iterations
+        FROM main.algorithms_data ad
+        JOIN main.representations_data rd
+            ON ad.algorithm_id = rd.algorithm_id
+        WHERE rd.dimensionality = $1::int[]
+            AND EXISTS (
+                SELECT 1 FROM main.representation_strings_data rsd
+                WHERE rsd.representation_id = rd.representation_id
+            )
+        ORDER BY rd.representation_id;
+    )" };
+    inline constexpr PreparedStatement get_by_iterations { "algorithm_representations_get_by_iterations", R"(
+        SELECT
+            ad.algorithm_id AS algorithm_id,
+            ad.name AS name,
+            ad.description AS description,
+            rd.representation_id AS representation_id,
+            rd.dimensionality AS dimensionality,
+            rd.iterations AS iterations
+        FROM main.algorithms_data ad
+        JOIN main.representations_data rd
+            ON ad.algorithm_id = rd.algorithm_id
+        WHERE rd.iterations = $1
+            AND EXISTS (
+                SELECT 1 FROM main.representation_strings_data rsd
+                WHERE rsd.representation_id = rd.representation_id
+            )
+        ORDER BY rd.representation_id;
+    )" };
+
+    inline constexpr PreparedStatement all[] = {
+        get_by_id, get_by_filter, get_ids_by_filter,
+        get_by_algorithm_id, get_by_name, get_by_description, get_by_representation_id, get_by_dimensionality, get_by_iterations,
+    };
+};
+
 AlgorithmRepresentationRepository::AlgorithmRepresentationRepository() 
     : connection(nullptr), 
+      owns_connection(false),
+      uses_shared_repositories(true),
       algorithm_repository(nullptr), 
       representation_repository(nullptr), 
       representation_string_repository(nullptr) {}
 
+AlgorithmRepresentationRepository::AlgorithmRepresentationRepository(IRepository<AlgorithmDTO>& algorithm_repository,
+        IRepository<RepresentationDTO>& representation_repository,
+        IRepository<RepresentationStringDTO>& representation_string_repository)
+    : connection(nullptr),
+      owns_connection(false),
+      uses_shared_repositories(false),
+      algorithm_repository(&algorithm_repository),
+      representation_repository(&representation_repository),
+      representation_string_repository(&representation_string_repository) {}
+
 AlgorithmRepresentationRepository::~AlgorithmRepresentationRepository()
 {
     disconnect();
@@ -13,6 +201,8 @@ AlgorithmRepresentationRepository::~AlgorithmRepresentationRepository()
 
 void AlgorithmRepresentationRepository::init()
 {
+    if (!uses_shared_repositories) return;
+
     algorithm_repository = &SharedRepository::get_instance().get_algorithm_repository();
     representation_repository = &SharedRepository::get_instance().get_representation_repository();
     representation_string_repository = &SharedRepository::get_instance().get_representation_string_repository();
@@ -21,12 +211,16 @@ void AlgorithmRepresentationRepository::init()
 void AlgorithmRepresentationRepository::connect(std::string connection)
 {
     this->connection = new pqxx::connection(connection);
+    this->owns_connection = true;
+    PreparedStatements::prepare(*this->connection, AlgorithmRepresentationStatements::all);
     init();
 }
 
 void AlgorithmRepresentationRepository::connect(pqxx::connection* connection)
 {
     this->connection = connection;
+    this->owns_connection = false;
+    PreparedStatements::prepare(*this->connection, AlgorithmRepresentationStatements::all);
     init();
 }
 
@@ -34,8 +228,13 @@ void AlgorithmRepresentationRepository::disconnect()
 {
     if (this->connection == nullptr) return;
 
-    delete this->connection;
+    if (this->owns_connection) {
+        delete this->connection;
+    }
     this->connection = nullptr;
+    this->owns_connection = false;
+
+    if (!this->uses_shared_repositories) return;
 
     this->algorithm_repository = nullptr;
     this->representation_repository = nullptr;
@@ -56,10 +255,7 @@ void AlgorithmRepresentationRepository::update(AlgorithmRepresentation object)
 {
     algorithm_repository->update(object.algorithm);
     representation_repository->update(object.representation);
-
-    for (auto representationString : object.representation_strings) {
-        representation_string_repository->update(representationString);
-    }
+    representation_string_repository->update_many(object.representation_strings);
 }
 
 void AlgorithmRepresentationRepository::remove(AlgorithmRepresentation object)
@@ -69,11 +265,23 @@ void AlgorithmRepresentationRepository::remove(AlgorithmRepresentation object)
 
 std::vector<AlgorithmRepresentation> AlgorithmRepresentationRepository::get_all()
 {
-    if (this->connection == nullptr) return {};
+    std::vector<AlgorithmRepresentation> algorithms_representations;
+    for_each([&algorithms_representations](AlgorithmRepresentation&& algorithm_representation) {
+        algorithms_representations.push_back(std::move(algorithm_representation));
+    });
+    return algorithms_representations;
+}
+
+void AlgorithmRepresentationRepository::for_each(const std::function<void(AlgorithmRepresentation&&)>& callback)
+{
+    if (this->connection == nullptr) return;
 
     pqxx::work tx(*this->connection);
 
-    pqxx::result rows = tx.exec(R"(
+    // два серверных курсора, упорядоченных по representation_id, читаются порциями и сливаются (merge join),
+    // поэтому в памяти находятся только текущие порции и одно собираемое представление
+    tx.exec(R"(
+        DECLARE algorithm_representations_cursor NO SCROLL CURSOR FOR
         SELECT
             ad.algorithm_id AS algorithm_id,
             ad.name AS name,
@@ -83,68 +291,134 @@ std::vector<AlgorithmRepresentation> AlgorithmRepresentationRepository::get_all(
             rd.iterations AS iterations
         FROM main.algorithms_data ad
         JOIN main.representations_data rd
-            ON ad.algorithm_id = rd.algorithm_id;
+            ON ad.algorithm_id = rd.algorithm_id
+        ORDER BY rd.representation_id;
+    )");
+    tx.exec(R"(
+        DECLARE representation_strings_cursor NO SCROLL CURSOR FOR
+        SELECT representation_string_id, representation_id, content, validity
+        FROM main.representation_strings_data
+        ORDER BY representation_id, representation_string_id;
     )");
-    tx.commit();
 
-    auto representation_strings_data = representation_string_repository->get_all();
+    const std::string fetch_representations = std::format("FETCH FORWARD {} FROM algorithm_representations_cursor;", representations_fetch_size);
+    const std::string fetch_representation_strings = std::format("FETCH FORWARD {} FROM representation_strings_cursor;", representation_strings_fetch_size);
+
+    pqxx::result string_rows = tx.exec(fetch_representation_strings);
+    size_t string_position = 0;
+
+    while (true) {
+        pqxx::result rows = tx.exec(fetch_representations);
+        if (rows.empty()) break;
+
+        for (const auto& row : rows) {
+            AlgorithmRepresentation algorithm_representation = make_algorithm_representation(row);
+            int representation_id = algorithm_representation.representation.representation_id;
+
+            while (!string_rows.empty()) {
+                if (string_position == string_rows.size()) {
+                    string_rows = tx.exec(fetch_representation_strings);
+                    string_position = 0;
+                    continue;
+                }
+
+                const auto& string_row = string_rows[string_position];
+                int string_representation_id = string_row["representation_id"].as<int>();
+                if (string_representation_id > representation_id) break;
+
+                string_position++;
+                // строки без представления (при целостной БД не встречаются) пропускаются
+                if (string_representation_id < representation_id) continue;
+
+                auto representation_string_id = string_row["representation_string_id"].as<long int>();
+                auto content = string_row["content"].as<std::string>();
+                auto validity_optional = string_row["validity"].as<std::optional<std::string>>();
+                auto validity = validity_optional.has_value() ? std::make_optional(json::parse(validity_optional.value())) : std::nullopt;
+                RepresentationStringDTO& representation_string = algorithm_representation.representation_strings.emplace_back(
+                    representation_string_id, representation_id, std::move(content), std::move(validity));
+                representation_string.mark_clean();
+            }
 
-    std::unordered_map<int, std::vector<RepresentationStringDTO>> representation_strings_map;
-    for (auto representationString : representation_strings_data) {
-        representation_strings_map[representationString.representation_id].push_back(representationString);
+            callback(std::move(algorithm_representation));
+        }
     }
 
+    tx.exec("CLOSE representation_strings_cursor;");
+    tx.exec("CLOSE algorithm_representations_cursor;");
+    tx.commit();
+}
+
+std::optional<AlgorithmRepresentation> AlgorithmRepresentationRepository::get_by_id(int id)
+{
+    if (this->connection == nullptr) return std::nullopt;
+
+    pqxx::work tx(*this->connection);
+
+    pqxx::result rows = tx.exec(pqxx::prepped{AlgorithmRepresentationStatements::get_by_id.name}, pqxx::params{id});
+
+    if (rows.empty()) return std::nullopt;
+
+    std::vector<AlgorithmRepresentation> algorithms_representations { make_algorithm_representation(rows.front()) };
+    load_representation_strings(tx, algorithms_representations);
+    tx.commit();
+
+    if (algorithms_representations.front().representation_strings.empty()) return std::nullopt;
+    return std::move(algorithms_representations.front());
+}
+
+std::vector<AlgorithmRepresentation> AlgorithmRepresentationRepository::get_by_filter(const AlgorithmRepresentationFilter& filter)
+{
+    if (this->connection == nullptr) return {};
+
+    auto name_patterns = make_like_patterns_by_words(filter.name);
+    pqxx::work tx(*this->connection);
+
+    pqxx::result rows = tx.exec(pqxx::prepped{AlgorithmRepresentationStatements::get_by_filter.name}, pqxx::params{
+        std::move(name_patterns),
+        filter.language,
+        filter.description,
+        filter.dimensionality,
+        filter.iterations
+    });
+
     std::vector<AlgorithmRepresentation> algorithms_representations;
     algorithms_representations.reserve(rows.size());
-    #pragma omp parallel for
     for (const auto& row : rows) {
-        int algorithm_id = row["algorithm_id"].as<int>();
-        std::string name = row["name"].as<std::string>();
-        std::string description = row["description"].as<std::string>();
-        int representation_id = row["representation_id"].as<int>();
-        auto dimensionality_arr = row["dimensionality"].as_sql_array<int>();
-        std::vector<int> dimensionality(dimensionality_arr.cbegin(), dimensionality_arr.cend());
-        int iterations = row["iterations"].as<int>();
-
-        AlgorithmDTO algorithm(algorithm_id, json::parse(name), json::parse(description));
-        RepresentationDTO representation(representation_id, algorithm_id, dimensionality, iterations);
-
-        #pragma omp critical
-        algorithms_representations.push_back(AlgorithmRepresentation(algorithm, representation, representation_strings_map[representation_id]));
+        algorithms_representations.push_back(make_algorithm_representation(row));
     }
 
-    std::sort(std::execution::par_unseq, algorithms_representations.begin(), algorithms_representations.end(), std::less<AlgorithmRepresentation>());
+    load_representation_strings(tx, algorithms_representations);
+    tx.commit();
+
     return algorithms_representations;
 }
 
-std::optional<AlgorithmRepresentation> AlgorithmRepresentationRepository::get_by_id(int id)
+std::vector<int> AlgorithmRepresentationRepository::get_ids_by_filter(const AlgorithmRepresentationFilter& filter)
 {
-    if (this->connection == nullptr) return std::nullopt;
+    if (this->connection == nullptr) return {};
 
+    auto name_patterns = make_like_patterns_by_words(filter.name);
     pqxx::work tx(*this->connection);
 
-    pqxx::result rows = tx.exec(R"(
-        SELECT
-            ad.algorithm_id AS algorithm_id,
-            ad.name AS name,
-            ad.description AS description,
-            rd.representation_id AS representation_id,
-            rd.dimensionality AS dimensionality,
-            rd.iterations AS iterations,
-            rsd.representation_string_id AS representation_string_id,
-            rsd.content AS content,
-            rsd.validity AS validity
-        FROM main.algorithms_data ad
-        JOIN main.representations_data rd
-            ON ad.algorithm_id = rd.algorithm_id
-        JOIN main.representation_strings_data rsd
-            ON rd.representation_id = rsd.representation_id
-        WHERE rd.representation_id = $1;
-    )", pqxx::params{id});
+    pqxx::result rows = tx.exec(pqxx::prepped{AlgorithmRepresentationStatements::get_ids_by_filter.name}, pqxx::params{
+        std::move(name_patterns),
+        filter.language,
+        filter.description,
+        filter.dimensionality,
+        filter.iterations
+    });
+    tx.commit();
 
-    if (rows.empty()) return std::nullopt;
+    std::vector<int> representation_ids;
+    representation_ids.reserve(rows.size());
+    for (const auto& row : rows) {
+        representation_ids.push_back(row["representation_id"].as<int>());
+    }
+    return representation_ids;
+}
 
-    auto row = rows.front();
+AlgorithmRepresentation AlgorithmRepresentationRepository::make_algorithm_representation(const pqxx::row& row)
+{
     int algorithm_id = row["algorithm_id"].as<int>();
     std::string name = row["name"].as<std::string>();
     std::string description = row["description"].as<std::string>();
@@ -152,112 +426,89 @@ std::optional<AlgorithmRepresentation> AlgorithmRepresentationRepository::get_by
     auto dimensionality_arr = row["dimensionality"].as_sql_array<int>();
     std::vector<int> dimensionality(dimensionality_arr.cbegin(), dimensionality_arr.cend());
     int iterations = row["iterations"].as<int>();
-    long int representation_string_id = row["representation_string_id"].as<long int>();
-    std::string content = row["content"].as<std::string>();
-    std::optional<std::string> validity_optional = row["validity"].as<std::optional<std::string>>();
 
-    auto validity = validity_optional.has_value() ? std::make_optional(json::parse(validity_optional.value())) : std::nullopt;
     AlgorithmDTO algorithm(algorithm_id, json::parse(name), json::parse(description));
     RepresentationDTO representation(representation_id, algorithm_id, dimensionality, iterations);
-    RepresentationStringDTO representation_string(representation_string_id, representation_id, content, validity);
+    algorithm.mark_clean();
+    representation.mark_clean();
+    return AlgorithmRepresentation(algorithm, representation, {});
+}
+
+void AlgorithmRepresentationRepository::load_representation_strings(pqxx::work& tx, std::vector<AlgorithmRepresentation>& algorithms_representations)
+{
+    if (algorithms_representations.empty()) return;
+
+    // COPY не принимает параметры, поэтому массив идентификаторов подставляется в текст запроса (только числа)
+    std::string representation_ids;
+    std::unordered_map<int, size_t> index_by_representation_id;
+    for (size_t i = 0; i < algorithms_representations.size(); i++) {
+        int representation_id = algorithms_representations[i].representation.representation_id;
+        representation_ids += (i == 0 ? "" : ",") + std::to_string(representation_id);
+        index_by_representation_id[representation_id] = i;
+    }
 
-    AlgorithmRepresentation algorithm_representation(algorithm, representation, {representation_string});
-    return algorithm_representation;
+    // строки приходят потоком (COPY) уже упорядоченными, поэтому сортировка не нужна
+    std::string query = std::format(R"(
+        SELECT representation_string_id, representation_id, content, validity
+        FROM main.representation_strings_data
+        WHERE representation_id = ANY('{{{0}}}'::int[])
+        ORDER BY representation_id, representation_string_id
+    )", representation_ids);
+
+    std::vector<RepresentationStringDTO>* representation_strings_data = nullptr;
+    int current_representation_id = 0;
+    for (auto&& [representation_string_id, representation_id, content, validity_optional] :
+            tx.stream<long int, int, std::string, std::optional<std::string>>(query)) {
+        if (representation_strings_data == nullptr || representation_id != current_representation_id) {
+            current_representation_id = representation_id;
+            representation_strings_data = &algorithms_representations[index_by_representation_id[representation_id]].representation_strings;
+        }
+
+        auto validity = validity_optional.has_value() ? std::make_optional(json::parse(validity_optional.value())) : std::nullopt;
+        RepresentationStringDTO& representation_string = representation_strings_data->emplace_back(
+            representation_string_id, representation_id, std::move(content), std::move(validity));
+        representation_string.mark_clean();
+    }
 }
 
 std::vector<AlgorithmRepresentation> AlgorithmRepresentationRepository::get_by_field(const std::string& field, const std::string& value)
 {
     if (this->connection == nullptr) return {};
-    if (field != "algorithm_id" && field != "name" && field != "description" && 
-        field != "representation_id" && field != "dimensionality" && field != "iterations") return {};
-    
-    pqxx::work tx(*this->connection);
 
-    auto regex = make_regex_by_words(value);
-    
-    std::string where_clause;
-    if (field == "algorithm_id")
-        where_clause = std::format("ad.algorithm_id = {}", regex);
-    else if (field == "name")
-        where_clause = std::format("ad.name->>main.lang() ~* '{}'", regex);
-    else if (field == "description")
-        where_clause = std::format("ad.description->>main.lang() ~* '{}'", regex);
-    else if (field == "representation_id")
-        where_clause = std::format("rd.representation_id = {}", regex);
-    else if (field == "dimensionality")
-        where_clause = std::format("rd.dimensionality = {}", regex);
-    else if (field == "iterations")
-        where_clause = std::format("rd.iterations = {}", regex);
-
-    std::string query = std::format(R"(
-        SELECT
-            ad.algorithm_id AS algorithm_id,
-            ad.name AS name,
-            ad.description AS description,
-            rd.representation_id AS representation_id,
-            rd.dimensionality AS dimensionality,
-            rd.iterations AS iterations,
-            jsonb_agg(rsd) AS representation_strings
-        FROM main.algorithms_data ad
-        JOIN main.representations_data rd
-            ON ad.algorithm_id = rd.algorithm_id
-        JOIN main.representation_strings_data rsd
-            ON rd.representation_id = rsd.representation_id
-        WHERE {0}
-        GROUP BY 
-            ad.algorithm_id, ad.name, ad.description, rd.representation_id, rd.dimensionality, rd.iterations;
-    )", where_clause);
+    pqxx::work tx(*this->connection);
 
-    pqxx::result rows = tx.exec(query);
+    pqxx::result rows;
+    if (field == "algorithm_id" || field == "representation_id" || field == "iterations") {
+        auto number = parse_integer_field_value(value);
+        if (!number.has_value()) return {};
+        const char* statement_name = field == "algorithm_id" ? AlgorithmRepresentationStatements::get_by_algorithm_id.name
+            : field == "representation_id" ? AlgorithmRepresentationStatements::get_by_representation_id.name
+            : AlgorithmRepresentationStatements::get_by_iterations.name;
+        rows = tx.exec(pqxx::prepped{statement_name}, pqxx::params{static_cast<int>(number.value())});
+    }
+    else if (field == "name" || field == "description") {
+        auto patterns = make_like_patterns_by_words(value);
+        const char* statement_name = field == "name" ? AlgorithmRepresentationStatements::get_by_name.name
+            : AlgorithmRepresentationStatements::get_by_description.name;
+        rows = tx.exec(pqxx::prepped{statement_name}, pqxx::params{std::move(patterns)});
+    }
+    else if (field == "dimensionality") {
+        auto dimensionality = parse_integer_array_field_value(value);
+        if (!dimensionality.has_value()) return {};
+        rows = tx.exec(pqxx::prepped{AlgorithmRepresentationStatements::get_by_dimensionality.name}, pqxx::params{dimensionality.value()});
+    }
+    else {
+        return {};
+    }
 
     std::vector<AlgorithmRepresentation> algorithms_representations;
     algorithms_representations.reserve(rows.size());
-
-    #pragma omp parallel for
     for (const auto& row : rows) {
-        int algorithm_id = row["algorithm_id"].as<int>();
-        std::string name = row["name"].as<std::string>();
-        std::string description = row["description"].as<std::string>();
-        int representation_id = row["representation_id"].as<int>();
-        auto dimensionality_arr = row["dimensionality"].as_sql_array<int>();
-        std::vector<int> dimensionality(dimensionality_arr.cbegin(), dimensionality_arr.cend());
-        int iterations = row["iterations"].as<int>();
-        std::string representation_strings = row["representation_strings"].as<std::string>();
-
-        json representation_strings_json = json::parse(representation_strings);
-        std::vector<RepresentationStringDTO> representation_strings_data;
-        for (const auto& representation_string_json : representation_strings_json) {
-            std::optional<json> validity;
-            try {
-            validity = representation_string_json["validity"] == nullptr 
-                ? std::nullopt 
-                : std::make_optional(representation_string_json["validity"]);
-            }
-            catch (const std::exception& e) {
-                validity = std::nullopt;
-            }
-
-            RepresentationStringDTO representation_string(
-                representation_string_json["representation_string_id"].get<int>(),
-                representation_string_json["representation_id"].get<int>(),
-                representation_string_json["content"].get<std::string>(),
-                validity
-            );
-            representation_strings_data.push_back(representation_string);
-        }
-
-        // сортируем representation_strings_data по representation_string_id
-        // параллельная сортировка
-        std::sort(std::execution::par_unseq, representation_strings_data.begin(), representation_strings_data.end(), [](const RepresentationStringDTO& a, const RepresentationStringDTO& b) {
-            return a.representation_string_id < b.representation_string_id;
-        });
-
-        AlgorithmDTO algorithm(algorithm_id, json::parse(name), json::parse(description));
-        RepresentationDTO representation(representation_id, algorithm_id, dimensionality, iterations);
-        AlgorithmRepresentation algorithm_representation(algorithm, representation, representation_strings_data);
-        #pragma omp critical
-        algorithms_representations.push_back(algorithm_representation);
+        algorithms_representations.push_back(make_algorithm_representation(row));
     }
 
+    load_representation_strings(tx, algorithms_representations);
+    tx.commit();
+
     return algorithms_representations;
 }
\ No newline at end of file
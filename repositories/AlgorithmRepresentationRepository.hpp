@@ -6,15 +6,23 @@
 #include <pqxx/pqxx>
 
 #include "IRepository.hpp"
+#include "IAlgorithmRepresentationRepository.hpp"
+#include "PreparedStatements.hpp"
 #include "../dto/AlgorithmDTO.hpp"
 #include "../dto/RepresentationDTO.hpp"
 #include "../dto/RepresentationStringDTO.hpp"
 #include "../dto/AlgorithmRepresentation.hpp"
+#include "../dto/AlgorithmRepresentationFilter.hpp"
 #include "SharedRepository.hpp"
 
-class AlgorithmRepresentationRepository : public IRepository<AlgorithmRepresentation> {
+class AlgorithmRepresentationRepository : public IAlgorithmRepresentationRepository {
 public:
     AlgorithmRepresentationRepository();
+    // репозитории таблиц, работающие на том же соединении (например, на соединении из ConnectionPool);
+    // без них используются репозитории SharedRepository
+    AlgorithmRepresentationRepository(IRepository<AlgorithmDTO>& algorithm_repository,
+        IRepository<RepresentationDTO>& representation_repository,
+        IRepository<RepresentationStringDTO>& representation_string_repository);
     ~AlgorithmRepresentationRepository();
 
     void init();
@@ -29,10 +37,22 @@ public:
     std::vector<AlgorithmRepresentation> get_all() override;
     std::optional<AlgorithmRepresentation> get_by_id(int id) override;
     std::vector<AlgorithmRepresentation> get_by_field(const std::string& field, const std::string& value) override;
+    std::vector<AlgorithmRepresentation> get_by_filter(const AlgorithmRepresentationFilter& filter) override;
+    std::vector<int> get_ids_by_filter(const AlgorithmRepresentationFilter& filter) override;
+    void for_each(const std::function<void(AlgorithmRepresentation&&)>& callback) override;
 
 private:
+    // количество строк, забираемых из серверных курсоров for_each() за один FETCH
+    static constexpr size_t representations_fetch_size = 1000;
+    static constexpr size_t representation_strings_fetch_size = 10000;
+
     pqxx::connection* connection;
+    bool owns_connection;
+    bool uses_shared_repositories;
     IRepository<AlgorithmDTO>* algorithm_repository;
     IRepository<RepresentationDTO>* representation_repository;
     IRepository<RepresentationStringDTO>* representation_string_repository;
+
+    static AlgorithmRepresentation make_algorithm_representation(const pqxx::row& row);
+    static void load_representation_strings(pqxx::work& tx, std::vector<AlgorithmRepresentation>& algorithms_representations);
 };
\ No newline at end of file
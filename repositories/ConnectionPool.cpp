@@ -0,0 +1,127 @@
+#include "ConnectionPool.hpp"
+
+#include <thread>
+#include <iostream>
+
+ConnectionPool::Lease::Lease(ConnectionPool* pool, size_t index)
+    : pool(pool), index(index) {}
+
+ConnectionPool::Lease::Lease(Lease&& other) noexcept
+    : pool(other.pool), index(other.index)
+{
+    other.pool = nullptr;
+}
+
+ConnectionPool::Lease& ConnectionPool::Lease::operator=(Lease&& other) noexcept
+{
+    if (this != &other) {
+        if (pool != nullptr) {
+            pool->release(index);
+        }
+        pool = other.pool;
+        index = other.index;
+        other.pool = nullptr;
+    }
+    return *this;
+}
+
+ConnectionPool::Lease::~Lease()
+{
+    if (pool != nullptr) {
+        pool->release(index);
+    }
+}
+
+pqxx::connection* ConnectionPool::Lease::get() const
+{
+    return pool->connections[index].get();
+}
+
+pqxx::connection& ConnectionPool::Lease::operator*() const
+{
+    return *get();
+}
+
+pqxx::connection* ConnectionPool::Lease::operator->() const
+{
+    return get();
+}
+
+void ConnectionPool::Lease::reconnect()
+{
+    pool->connections[index] = pool->open_connection();
+}
+
+ConnectionPool::ConnectionPool(const std::string& connection_string, size_t size)
+    : connection_string(connection_string), was_connected(false)
+{
+    if (size == 0) {
+        throw std::invalid_argument("ConnectionPool::ConnectionPool() size must be positive");
+    }
+
+    // соединения открываются сразу, чтобы ошибки подключения возникали до начала работы
+    connections.reserve(size);
+    idle_indices.reserve(size);
+    for (size_t i = 0; i < size; i++) {
+        connections.push_back(open_connection());
+        idle_indices.push_back(i);
+    }
+}
+
+ConnectionPool::~ConnectionPool() {}
+
+ConnectionPool::Lease ConnectionPool::acquire()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    connection_released.wait(lock, [this]() { return !idle_indices.empty(); });
+
+    size_t index = idle_indices.back();
+    idle_indices.pop_back();
+    lock.unlock();
+
+    // разорванное соединение заменяется новым
+    if (!connections[index]->is_open()) {
+        try {
+            connections[index] = open_connection();
+        }
+        catch (...) {
+            release(index);
+            throw;
+        }
+    }
+    return Lease(this, index);
+}
+
+size_t ConnectionPool::size() const
+{
+    return connections.size();
+}
+
+std::unique_ptr<pqxx::connection> ConnectionPool::open_connection()
+{
+    auto delay = initial_delay;
+    for (size_t attempt = 1; ; attempt++) {
+        try {
+            auto connection = std::make_unique<pqxx::connection>(connection_string);
+            was_connected = true;
+            return connection;
+        }
+        catch (const pqxx::broken_connection& e) {
+            if (!was_connected || attempt >= max_attempts) {
+                throw;
+            }
+            std::cerr << "ConnectionPool: connection failed, retrying in " << delay.count() << " ms: " << e.what() << std::endl;
+            std::this_thread::sleep_for(delay);
+            delay *= 2;
+        }
+    }
+}
+
+void ConnectionPool::release(size_t index)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        idle_indices.push_back(index);
+    }
+    connection_released.notify_one();
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <stdexcept>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <pqxx/pqxx>
+
+// пул соединений фиксированного размера
+// соединение выдаётся в монопольное пользование на время жизни Lease и возвращается в пул в его деструкторе;
+// если свободных соединений нет, acquire() ждёт возврата
+// новые соединения (вместо разорванных) открываются с повторными попытками и экспоненциальной задержкой;
+// пока ни одно соединение не открылось, ошибка не повторяется: неверная строка подключения или пароль сообщаются сразу
+class ConnectionPool {
+public:
+    class Lease {
+    public:
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        ~Lease();
+
+        pqxx::connection* get() const;
+        pqxx::connection& operator*() const;
+        pqxx::connection* operator->() const;
+        // заменяет соединение новым (после pqxx::broken_connection), прежние указатели становятся недействительными
+        void reconnect();
+
+    private:
+        friend class ConnectionPool;
+        Lease(ConnectionPool* pool, size_t index);
+
+        ConnectionPool* pool;
+        size_t index;
+    };
+
+    ConnectionPool(const std::string& connection_string, size_t size);
+    ~ConnectionPool();
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    Lease acquire();
+    size_t size() const;
+
+private:
+    // число попыток открыть соединение и задержка перед второй попыткой (далее удваивается)
+    static constexpr size_t max_attempts = 6;
+    static constexpr std::chrono::milliseconds initial_delay { 500 };
+
+    std::string connection_string;
+    std::vector<std::unique_ptr<pqxx::connection>> connections;
+    std::vector<size_t> idle_indices;
+    std::mutex mutex;
+    std::condition_variable connection_released;
+    std::atomic<bool> was_connected;
+
+    std::unique_ptr<pqxx::connection> open_connection();
+    void release(size_t index);
+};
\ No newline at end of file
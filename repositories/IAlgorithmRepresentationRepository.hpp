@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+
+#include "IRepository.hpp"
+#include "../dto/AlgorithmRepresentation.hpp"
+#include "../dto/AlgorithmRepresentationFilter.hpp"
+
+// запросы, специфичные для представлений алгоритмов
+struct IAlgorithmRepresentationRepository : IRepository<AlgorithmRepresentation> {
+    // подходящие представления вместе со строками (строки загружаются только для них)
+    virtual std::vector<AlgorithmRepresentation> get_by_filter(const AlgorithmRepresentationFilter& filter) = 0;
+    // только идентификаторы подходящих представлений, без строк
+    virtual std::vector<int> get_ids_by_filter(const AlgorithmRepresentationFilter& filter) = 0;
+    // обход всех представлений по возрастанию representation_id, по одному собранному представлению за раз;
+    // обход идёт внутри транзакции, поэтому callback не должен обращаться к БД через то же соединение
+    virtual void for_each(const std::function<void(AlgorithmRepresentation&&)>& callback) = 0;
+};
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include <optional>
 #include <string>
 #include <vector>
+#include <ranges>
+#include <charconv>
+#include <string_view>
 #include <pqxx/pqxx>
 
 // данный репозиторий является вариантом DAO (Data Access Object)
@@ -19,19 +22,71 @@ struct IRepository {
     virtual void update(T object) = 0;
     virtual void remove(T object) = 0;
 
+    // массовое обновление; по умолчанию — построчно, репозитории с большими таблицами переопределяют
+    virtual void update_many(const std::vector<T>& objects)
+    {
+        for (const auto& object : objects) {
+            update(object);
+        }
+    }
+
     virtual std::vector<T> get_all() = 0;
     virtual std::optional<T> get_by_id(int id) = 0;
     virtual std::vector<T> get_by_field(const std::string& field, const std::string& value) = 0;
 };
 
-inline std::string make_regex_by_words(std::string_view value)
+// значения поиска get_by_field() передаются в запрос только параметрами:
+// для числовых полей — разобранными числами, для текстовых — шаблонами ILIKE по словам
+
+// шаблоны "%слово%" для ILIKE ALL (все слова должны входить); спецсимволы LIKE экранируются.
+// ILIKE ALL с пустым массивом истинно для любой строки: поиск без слов находит всё, как прежний поиск по регулярному выражению
+inline std::vector<std::string> make_like_patterns_by_words(std::string_view value)
+{
+    std::vector<std::string> patterns;
+    for (auto&& word : value | std::views::split(' ')) {
+        std::string_view sv(word.begin(), word.end());
+        if (sv.empty()) continue;
+
+        std::string pattern = "%";
+        for (char symbol : sv) {
+            if (symbol == '%' || symbol == '_' || symbol == '\\') {
+                pattern += '\\';
+            }
+            pattern += symbol;
+        }
+        pattern += '%';
+        patterns.push_back(std::move(pattern));
+    }
+    return patterns;
+}
+
+inline std::optional<long int> parse_integer_field_value(std::string_view value)
+{
+    long int result = 0;
+    auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (error != std::errc() || end != value.data() + value.size()) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+// массив целых чисел: "2 3", "2,3" или "{2,3}"
+inline std::optional<std::vector<int>> parse_integer_array_field_value(std::string_view value)
 {
-    return value
-        | std::views::split(' ')
-        | std::views::transform([](auto&& word) {
+    std::vector<int> result;
+    for (auto&& item : value | std::views::split(',')) {
+        for (auto&& word : item | std::views::split(' ')) {
             std::string_view sv(word.begin(), word.end());
-            return "(?=.*" + std::string(sv) + ")";
-          })
-        | std::views::join
-        | std::ranges::to<std::string>();
+            while (!sv.empty() && (sv.front() == '{' || sv.front() == '[')) sv.remove_prefix(1);
+            while (!sv.empty() && (sv.back() == '}' || sv.back() == ']')) sv.remove_suffix(1);
+            if (sv.empty()) continue;
+
+            auto number = parse_integer_field_value(sv);
+            if (!number.has_value()) {
+                return std::nullopt;
+            }
+            result.push_back(static_cast<int>(number.value()));
+        }
+    }
+    return result;
 }
\ No newline at end of file
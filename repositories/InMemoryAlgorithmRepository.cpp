@@ -0,0 +1,105 @@
+#include "InMemoryAlgorithmRepository.hpp"
+
+#include <algorithm>
+
+InMemoryAlgorithmRepository::InMemoryAlgorithmRepository(InMemoryDatabase& database)
+    : database(database) {}
+
+void InMemoryAlgorithmRepository::connect(std::string) {}
+
+void InMemoryAlgorithmRepository::connect(pqxx::connection*) {}
+
+void InMemoryAlgorithmRepository::disconnect() {}
+
+void InMemoryAlgorithmRepository::add(AlgorithmDTO object)
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    object.algorithm_id = database.next_algorithm_id++;
+    object.mark_clean();
+    database.algorithms.insert_or_assign(object.algorithm_id, std::move(object));
+}
+
+void InMemoryAlgorithmRepository::update(AlgorithmDTO object)
+{
+    // как и в AlgorithmRepository, записываются только изменённые поля
+    if (!object.is_dirty()) return;
+
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    if (!database.algorithms.contains(object.algorithm_id)) return;
+
+    AlgorithmDTO& stored = database.algorithms.at(object.algorithm_id);
+    if (object.is_name_dirty()) {
+        stored.name = object.name;
+    }
+    if (object.is_description_dirty()) {
+        stored.description = object.description;
+    }
+    stored.mark_clean();
+    database.mark_changed_algorithm(object.algorithm_id);
+}
+
+void InMemoryAlgorithmRepository::remove(AlgorithmDTO object)
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    // ON DELETE CASCADE для представлений алгоритма
+    std::vector<int> representation_ids;
+    for (const auto& [representation_id, representation] : database.representations) {
+        if (representation.algorithm_id == object.algorithm_id) {
+            representation_ids.push_back(representation_id);
+        }
+    }
+    for (int representation_id : representation_ids) {
+        database.remove_representation(representation_id);
+    }
+    database.algorithms.erase(object.algorithm_id);
+}
+
+std::vector<AlgorithmDTO> InMemoryAlgorithmRepository::get_all()
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    std::vector<AlgorithmDTO> algorithms_data;
+    algorithms_data.reserve(database.algorithms.size());
+    for (const auto& [algorithm_id, algorithm] : database.algorithms) {
+        algorithms_data.push_back(algorithm);
+    }
+    std::sort(algorithms_data.begin(), algorithms_data.end());
+    return algorithms_data;
+}
+
+std::optional<AlgorithmDTO> InMemoryAlgorithmRepository::get_by_id(int id)
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    auto algorithm = database.algorithms.find(id);
+    if (algorithm == database.algorithms.end()) return std::nullopt;
+    return algorithm->second;
+}
+
+std::vector<AlgorithmDTO> InMemoryAlgorithmRepository::get_by_field(const std::string& field, const std::string& value)
+{
+    if (field == "algorithm_id") {
+        auto algorithm_id = parse_integer_field_value(value);
+        if (!algorithm_id.has_value()) return {};
+        auto algorithm = get_by_id(static_cast<int>(algorithm_id.value()));
+        if (!algorithm.has_value()) return {};
+        return { algorithm.value() };
+    }
+    if (field != "name" && field != "description") {
+        return {};
+    }
+
+    auto search_words = InMemoryDatabase::make_search_words(value);
+
+    std::vector<AlgorithmDTO> algorithms_data;
+    for (const auto& algorithm : get_all()) {
+        const json& text = field == "name" ? algorithm.name : algorithm.description;
+        if (InMemoryDatabase::contains_words(InMemoryDatabase::search_text(text), search_words)) {
+            algorithms_data.push_back(algorithm);
+        }
+    }
+    return algorithms_data;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "IRepository.hpp"
+#include "InMemoryDatabase.hpp"
+#include "../dto/AlgorithmDTO.hpp"
+
+// AlgorithmRepository над InMemoryDatabase (без сервера БД)
+class InMemoryAlgorithmRepository : public IRepository<AlgorithmDTO> {
+public:
+    explicit InMemoryAlgorithmRepository(InMemoryDatabase& database);
+
+    // соединения нет, данные уже в InMemoryDatabase
+    void connect(std::string connection) override;
+    void connect(pqxx::connection* connection) override;
+    void disconnect() override;
+
+    void add(AlgorithmDTO object) override;
+    void update(AlgorithmDTO object) override;
+    void remove(AlgorithmDTO object) override;
+
+    std::vector<AlgorithmDTO> get_all() override;
+    std::optional<AlgorithmDTO> get_by_id(int id) override;
+    std::vector<AlgorithmDTO> get_by_field(const std::string& field, const std::string& value) override;
+
+private:
+    InMemoryDatabase& database;
+};
\ No newline at end of file
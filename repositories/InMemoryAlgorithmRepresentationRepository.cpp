@@ -0,0 +1,219 @@
+#include "InMemoryAlgorithmRepresentationRepository.hpp"
+
+#include <algorithm>
+
+InMemoryAlgorithmRepresentationRepository::InMemoryAlgorithmRepresentationRepository(InMemoryDatabase& database)
+    : database(database) {}
+
+void InMemoryAlgorithmRepresentationRepository::connect(std::string) {}
+
+void InMemoryAlgorithmRepresentationRepository::connect(pqxx::connection*) {}
+
+void InMemoryAlgorithmRepresentationRepository::disconnect() {}
+
+void InMemoryAlgorithmRepresentationRepository::add(AlgorithmRepresentation object)
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    object.algorithm.algorithm_id = database.next_algorithm_id++;
+    object.representation.representation_id = database.next_representation_id++;
+    object.representation.algorithm_id = object.algorithm.algorithm_id;
+
+    auto& string_ids = database.representation_string_ids[object.representation.representation_id];
+    for (auto& representation_string : object.representation_strings) {
+        representation_string.representation_string_id = database.next_representation_string_id++;
+        representation_string.representation_id = object.representation.representation_id;
+        string_ids.insert(representation_string.representation_string_id);
+    }
+
+    object.mark_clean();
+    database.algorithms.insert_or_assign(object.algorithm.algorithm_id, object.algorithm);
+    database.representations.insert_or_assign(object.representation.representation_id, object.representation);
+    for (auto& representation_string : object.representation_strings) {
+        database.representation_strings.insert_or_assign(representation_string.representation_string_id, std::move(representation_string));
+    }
+    database.mark_changed_representation(object.representation.representation_id);
+}
+
+void InMemoryAlgorithmRepresentationRepository::update(AlgorithmRepresentation object)
+{
+    // как и в AlgorithmRepresentationRepository, записываются только изменённые поля
+    if (!object.is_dirty()) return;
+
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    if (object.algorithm.is_dirty() && database.algorithms.contains(object.algorithm.algorithm_id)) {
+        AlgorithmDTO& stored = database.algorithms.at(object.algorithm.algorithm_id);
+        if (object.algorithm.is_name_dirty()) {
+            stored.name = object.algorithm.name;
+        }
+        if (object.algorithm.is_description_dirty()) {
+            stored.description = object.algorithm.description;
+        }
+        stored.mark_clean();
+        database.mark_changed_algorithm(stored.algorithm_id);
+    }
+
+    if (object.representation.is_dirty() && database.representations.contains(object.representation.representation_id)) {
+        RepresentationDTO& stored = database.representations.at(object.representation.representation_id);
+        if (object.representation.is_dimensionality_dirty()) {
+            stored.dimensionality = object.representation.dimensionality;
+        }
+        if (object.representation.is_iterations_dirty()) {
+            stored.iterations = object.representation.iterations;
+        }
+        stored.mark_clean();
+    }
+
+    for (const auto& representation_string : object.representation_strings) {
+        if (!representation_string.is_dirty() || !database.representation_strings.contains(representation_string.representation_string_id)) continue;
+
+        RepresentationStringDTO& stored = database.representation_strings.at(representation_string.representation_string_id);
+        if (representation_string.is_content_dirty()) {
+            stored.content = representation_string.content;
+        }
+        if (representation_string.is_validity_dirty()) {
+            stored.validity = representation_string.validity;
+        }
+        stored.mark_clean();
+    }
+    database.mark_changed_representation(object.representation.representation_id);
+}
+
+void InMemoryAlgorithmRepresentationRepository::remove(AlgorithmRepresentation object)
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    // как и AlgorithmRepresentationRepository::remove(), удаляется алгоритм вместе со всеми представлениями
+    std::vector<int> representation_ids = find_representation_ids([&object](const AlgorithmDTO& algorithm, const RepresentationDTO&) {
+        return algorithm.algorithm_id == object.algorithm.algorithm_id;
+    });
+    for (int representation_id : representation_ids) {
+        database.remove_representation(representation_id);
+    }
+    database.algorithms.erase(object.algorithm.algorithm_id);
+}
+
+std::vector<AlgorithmRepresentation> InMemoryAlgorithmRepresentationRepository::get_all()
+{
+    std::vector<AlgorithmRepresentation> algorithms_representations;
+    for_each([&algorithms_representations](AlgorithmRepresentation&& algorithm_representation) {
+        algorithms_representations.push_back(std::move(algorithm_representation));
+    });
+    return algorithms_representations;
+}
+
+void InMemoryAlgorithmRepresentationRepository::for_each(const std::function<void(AlgorithmRepresentation&&)>& callback)
+{
+    // снимок идентификаторов, чтобы callback мог обращаться к репозиториям
+    std::vector<int> representation_ids = find_representation_ids([](const AlgorithmDTO&, const RepresentationDTO&) { return true; });
+    for (int representation_id : representation_ids) {
+        auto algorithm_representation = database.make_algorithm_representation(representation_id);
+        if (!algorithm_representation.has_value() || algorithm_representation->representation_strings.empty()) continue;
+
+        algorithm_representation->mark_clean();
+        callback(std::move(algorithm_representation.value()));
+    }
+}
+
+std::optional<AlgorithmRepresentation> InMemoryAlgorithmRepresentationRepository::get_by_id(int id)
+{
+    auto algorithm_representations = make_algorithm_representations({ id }, true);
+    if (algorithm_representations.empty()) return std::nullopt;
+    return std::move(algorithm_representations.front());
+}
+
+std::vector<AlgorithmRepresentation> InMemoryAlgorithmRepresentationRepository::get_by_field(const std::string& field, const std::string& value)
+{
+    std::function<bool(const AlgorithmDTO&, const RepresentationDTO&)> predicate;
+    if (field == "algorithm_id" || field == "representation_id" || field == "iterations") {
+        auto number = parse_integer_field_value(value);
+        if (!number.has_value()) return {};
+        int expected = static_cast<int>(number.value());
+        predicate = [&field, expected](const AlgorithmDTO& algorithm, const RepresentationDTO& representation) {
+            int actual = field == "algorithm_id" ? algorithm.algorithm_id
+                : field == "representation_id" ? representation.representation_id
+                : representation.iterations;
+            return actual == expected;
+        };
+    }
+    else if (field == "name" || field == "description") {
+        predicate = [&field, search_words = InMemoryDatabase::make_search_words(value)](const AlgorithmDTO& algorithm, const RepresentationDTO&) {
+            const json& text = field == "name" ? algorithm.name : algorithm.description;
+            return InMemoryDatabase::contains_words(InMemoryDatabase::search_text(text), search_words);
+        };
+    }
+    else if (field == "dimensionality") {
+        auto dimensionality = parse_integer_array_field_value(value);
+        if (!dimensionality.has_value()) return {};
+        predicate = [expected = dimensionality.value()](const AlgorithmDTO&, const RepresentationDTO& representation) {
+            return representation.dimensionality == expected;
+        };
+    }
+    else {
+        return {};
+    }
+
+    return make_algorithm_representations(find_representation_ids(predicate), true);
+}
+
+std::vector<AlgorithmRepresentation> InMemoryAlgorithmRepresentationRepository::get_by_filter(const AlgorithmRepresentationFilter& filter)
+{
+    return make_algorithm_representations(get_ids_by_filter(filter), true);
+}
+
+std::vector<int> InMemoryAlgorithmRepresentationRepository::get_ids_by_filter(const AlgorithmRepresentationFilter& filter)
+{
+    auto search_words = InMemoryDatabase::make_search_words(filter.name);
+
+    // как и в get_by_field(), представления без строк не возвращаются
+    return find_representation_ids([this, &filter, &search_words](const AlgorithmDTO& algorithm, const RepresentationDTO& representation) {
+        auto string_ids = database.representation_string_ids.find(representation.representation_id);
+        if (string_ids == database.representation_string_ids.end() || string_ids->second.empty()) {
+            return false;
+        }
+        // название на языке фильтра, как name->>main.lang() в PostgreSQL; названия без этого языка не подходят
+        auto name = InMemoryDatabase::language_text(algorithm.name, filter.language);
+        if (!name.has_value() || !InMemoryDatabase::contains_words(name.value(), search_words)) {
+            return false;
+        }
+
+        // пустое описание (NULL) или "-" подходит к любому запрошенному описанию
+        auto description = InMemoryDatabase::language_text(algorithm.description, filter.language);
+        if (description.has_value() && description.value() != "-" && description.value() != filter.description) {
+            return false;
+        }
+
+        return representation.dimensionality == filter.dimensionality && representation.iterations == filter.iterations;
+    });
+}
+
+std::vector<int> InMemoryAlgorithmRepresentationRepository::find_representation_ids(const std::function<bool(const AlgorithmDTO&, const RepresentationDTO&)>& predicate) const
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    std::vector<int> representation_ids;
+    for (const auto& [representation_id, representation] : database.representations) {
+        auto algorithm = database.algorithms.find(representation.algorithm_id);
+        if (algorithm != database.algorithms.end() && predicate(algorithm->second, representation)) {
+            representation_ids.push_back(representation_id);
+        }
+    }
+    std::sort(representation_ids.begin(), representation_ids.end());
+    return representation_ids;
+}
+
+std::vector<AlgorithmRepresentation> InMemoryAlgorithmRepresentationRepository::make_algorithm_representations(const std::vector<int>& representation_ids, bool skip_without_strings) const
+{
+    std::vector<AlgorithmRepresentation> algorithms_representations;
+    algorithms_representations.reserve(representation_ids.size());
+    for (int representation_id : representation_ids) {
+        auto algorithm_representation = database.make_algorithm_representation(representation_id);
+        if (!algorithm_representation.has_value()) continue;
+        if (skip_without_strings && algorithm_representation->representation_strings.empty()) continue;
+
+        algorithm_representation->mark_clean();
+        algorithms_representations.push_back(std::move(algorithm_representation.value()));
+    }
+    return algorithms_representations;
+}
\ No newline at end of file
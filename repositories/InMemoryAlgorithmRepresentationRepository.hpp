@@ -0,0 +1,36 @@
+#pragma once
+
+#include "IAlgorithmRepresentationRepository.hpp"
+#include "InMemoryDatabase.hpp"
+#include "../dto/AlgorithmRepresentation.hpp"
+#include "../dto/AlgorithmRepresentationFilter.hpp"
+
+// AlgorithmRepresentationRepository над InMemoryDatabase (без сервера БД)
+// порядок и отбор совпадают с запросами AlgorithmRepresentationRepository
+class InMemoryAlgorithmRepresentationRepository : public IAlgorithmRepresentationRepository {
+public:
+    explicit InMemoryAlgorithmRepresentationRepository(InMemoryDatabase& database);
+
+    // соединения нет, данные уже в InMemoryDatabase
+    void connect(std::string connection) override;
+    void connect(pqxx::connection* connection) override;
+    void disconnect() override;
+
+    void add(AlgorithmRepresentation object) override;
+    void update(AlgorithmRepresentation object) override;
+    void remove(AlgorithmRepresentation object) override;
+
+    std::vector<AlgorithmRepresentation> get_all() override;
+    std::optional<AlgorithmRepresentation> get_by_id(int id) override;
+    std::vector<AlgorithmRepresentation> get_by_field(const std::string& field, const std::string& value) override;
+    std::vector<AlgorithmRepresentation> get_by_filter(const AlgorithmRepresentationFilter& filter) override;
+    std::vector<int> get_ids_by_filter(const AlgorithmRepresentationFilter& filter) override;
+    void for_each(const std::function<void(AlgorithmRepresentation&&)>& callback) override;
+
+private:
+    InMemoryDatabase& database;
+
+    // идентификаторы представлений по возрастанию, для которых predicate(алгоритм, представление) истинен
+    std::vector<int> find_representation_ids(const std::function<bool(const AlgorithmDTO&, const RepresentationDTO&)>& predicate) const;
+    std::vector<AlgorithmRepresentation> make_algorithm_representations(const std::vector<int>& representation_ids, bool skip_without_strings) const;
+};
\ No newline at end of file
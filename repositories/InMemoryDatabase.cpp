@@ -0,0 +1,187 @@
+#include "InMemoryDatabase.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <ranges>
+
+#include "../utils/RepresentationSnapshot.hpp"
+
+InMemoryDatabase::InMemoryDatabase(const std::string& directory, bool write_back)
+    : next_algorithm_id(1),
+      next_representation_id(1),
+      next_representation_string_id(1),
+      directory(directory),
+      write_back(write_back) {}
+
+InMemoryDatabase::~InMemoryDatabase()
+{
+    try {
+        save();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "InMemoryDatabase: " << e.what() << std::endl;
+    }
+}
+
+void InMemoryDatabase::load()
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    if (directory.empty() || !std::filesystem::exists(directory)) return;
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (!entry.is_regular_file() || entry.path().extension() != RepresentationSnapshot::file_extension) continue;
+
+        auto algorithm_representation = RepresentationSnapshot::read(entry.path().string());
+        if (!algorithm_representation.has_value()) {
+            std::cerr << "InMemoryDatabase: skipped " << entry.path().string() << std::endl;
+            continue;
+        }
+
+        const auto& algorithm = algorithm_representation->algorithm;
+        const auto& representation = algorithm_representation->representation;
+        algorithms.insert_or_assign(algorithm.algorithm_id, algorithm);
+        representations.insert_or_assign(representation.representation_id, representation);
+        next_algorithm_id = std::max(next_algorithm_id, algorithm.algorithm_id + 1);
+        next_representation_id = std::max(next_representation_id, representation.representation_id + 1);
+
+        auto& string_ids = representation_string_ids[representation.representation_id];
+        for (auto& representation_string : algorithm_representation->representation_strings) {
+            string_ids.insert(representation_string.representation_string_id);
+            next_representation_string_id = std::max(next_representation_string_id, representation_string.representation_string_id + 1);
+            representation_strings.insert_or_assign(representation_string.representation_string_id, std::move(representation_string));
+        }
+    }
+}
+
+void InMemoryDatabase::save()
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    if (!write_back || directory.empty() || changed_representation_ids.empty()) return;
+
+    std::filesystem::create_directories(directory);
+    for (int representation_id : changed_representation_ids) {
+        std::string file_path = (std::filesystem::path(directory) / RepresentationSnapshot::file_name(representation_id)).string();
+
+        auto algorithm_representation = make_algorithm_representation(representation_id);
+        if (algorithm_representation.has_value()) {
+            RepresentationSnapshot::write(file_path, algorithm_representation.value(), "");
+        }
+        else {
+            std::error_code error;
+            std::filesystem::remove(file_path, error);
+        }
+    }
+    changed_representation_ids.clear();
+}
+
+std::optional<AlgorithmRepresentation> InMemoryDatabase::make_algorithm_representation(int representation_id) const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    auto representation = representations.find(representation_id);
+    if (representation == representations.end()) return std::nullopt;
+    auto algorithm = algorithms.find(representation->second.algorithm_id);
+    if (algorithm == algorithms.end()) return std::nullopt;
+
+    std::vector<RepresentationStringDTO> strings;
+    auto string_ids = representation_string_ids.find(representation_id);
+    if (string_ids != representation_string_ids.end()) {
+        strings.reserve(string_ids->second.size());
+        for (long int representation_string_id : string_ids->second) {
+            strings.push_back(representation_strings.at(representation_string_id));
+        }
+    }
+    return AlgorithmRepresentation(algorithm->second, representation->second, std::move(strings));
+}
+
+void InMemoryDatabase::mark_changed_representation(int representation_id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    changed_representation_ids.insert(representation_id);
+}
+
+void InMemoryDatabase::mark_changed_algorithm(int algorithm_id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    for (const auto& [representation_id, representation] : representations) {
+        if (representation.algorithm_id == algorithm_id) {
+            changed_representation_ids.insert(representation_id);
+        }
+    }
+}
+
+void InMemoryDatabase::remove_representation(int representation_id)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+
+    // ON DELETE CASCADE для строк представления
+    auto string_ids = representation_string_ids.find(representation_id);
+    if (string_ids != representation_string_ids.end()) {
+        for (long int representation_string_id : string_ids->second) {
+            representation_strings.erase(representation_string_id);
+        }
+        representation_string_ids.erase(string_ids);
+    }
+    representations.erase(representation_id);
+    changed_representation_ids.insert(representation_id);
+}
+
+std::vector<std::string> InMemoryDatabase::make_search_words(std::string_view value)
+{
+    std::vector<std::string> search_words;
+    for (auto&& word : value | std::views::split(' ')) {
+        std::string_view sv(word.begin(), word.end());
+        if (sv.empty()) continue;
+        search_words.push_back(to_lower(sv));
+    }
+    return search_words;
+}
+
+bool InMemoryDatabase::contains_words(std::string_view text, const std::vector<std::string>& search_words)
+{
+    std::string lowercase_text = to_lower(text);
+    return std::all_of(search_words.begin(), search_words.end(), [&lowercase_text](const std::string& search_word) {
+        return lowercase_text.find(search_word) != std::string::npos;
+    });
+}
+
+std::string InMemoryDatabase::search_text(const json& value)
+{
+    return language_text(value, "en").value_or("") + " " + language_text(value, "ru").value_or("");
+}
+
+std::optional<std::string> InMemoryDatabase::language_text(const json& value, const std::string& language)
+{
+    if (!value.is_object() || !value.contains(language) || value[language].is_null()) return std::nullopt;
+    return value[language].is_string() ? value[language].get<std::string>() : value[language].dump();
+}
+
+std::string InMemoryDatabase::to_lower(std::string_view text)
+{
+    std::string result(text);
+    for (size_t i = 0; i < result.size(); i++) {
+        unsigned char symbol = result[i];
+        if (symbol >= 'A' && symbol <= 'Z') {
+            result[i] = static_cast<char>(symbol + ('a' - 'A'));
+        }
+        else if (symbol == 0xD0 && i + 1 < result.size()) {
+            unsigned char next = result[i + 1];
+            if (next >= 0x90 && next <= 0x9F) {             // А-П
+                result[i + 1] = static_cast<char>(next + 0x20);
+            }
+            else if (next >= 0xA0 && next <= 0xAF) {        // Р-Я
+                result[i] = static_cast<char>(0xD1);
+                result[i + 1] = static_cast<char>(next - 0x20);
+            }
+            else if (next == 0x81) {                        // Ё
+                result[i] = static_cast<char>(0xD1);
+                result[i + 1] = static_cast<char>(0x91);
+            }
+            i++;
+        }
+    }
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <set>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <optional>
+#include <string_view>
+#include <tsl/hopscotch_map.h>
+
+#include "../dto/AlgorithmDTO.hpp"
+#include "../dto/RepresentationDTO.hpp"
+#include "../dto/RepresentationStringDTO.hpp"
+#include "../dto/AlgorithmRepresentation.hpp"
+
+// таблицы БД в памяти процесса для репозиториев InMemory* (хранилища Memory и Snapshot)
+// начальные данные читаются из каталога снимков представлений (формат RepresentationSnapshot,
+// например каталог SnapshotCacheDir); в хранилище Snapshot изменённые представления записываются обратно в save().
+// алгоритмы без представлений в снимках не хранятся.
+// таблицы открыты репозиториям, обращение к ним — только под mutex
+class InMemoryDatabase {
+public:
+    InMemoryDatabase(const std::string& directory, bool write_back);
+    ~InMemoryDatabase();
+    InMemoryDatabase(const InMemoryDatabase&) = delete;
+    InMemoryDatabase& operator=(const InMemoryDatabase&) = delete;
+
+    void load();
+    void save();
+
+    // представление со строками по возрастанию representation_string_id
+    std::optional<AlgorithmRepresentation> make_algorithm_representation(int representation_id) const;
+    void mark_changed_representation(int representation_id);
+    void mark_changed_algorithm(int algorithm_id);
+    void remove_representation(int representation_id);
+
+    // поиск как ILIKE ALL(...) в репозиториях PostgreSQL: каждое слово входит в текст без учёта регистра;
+    // поиск без слов находит всё
+    static std::vector<std::string> make_search_words(std::string_view value);
+    static bool contains_words(std::string_view text, const std::vector<std::string>& search_words);
+    // названия и описания по всем языкам (в памяти нет языка сессии main.lang())
+    static std::string search_text(const json& value);
+    // значение на одном языке; nullopt — значения на этом языке нет (NULL)
+    static std::optional<std::string> language_text(const json& value, const std::string& language);
+    // нижний регистр для латиницы и кириллицы в UTF-8, остальные символы не меняются
+    static std::string to_lower(std::string_view text);
+
+    mutable std::recursive_mutex mutex;
+    tsl::hopscotch_map<int, AlgorithmDTO> algorithms;
+    tsl::hopscotch_map<int, RepresentationDTO> representations;
+    tsl::hopscotch_map<long int, RepresentationStringDTO> representation_strings;
+    // representation_id -> идентификаторы строк представления
+    tsl::hopscotch_map<int, std::set<long int>> representation_string_ids;
+
+    int next_algorithm_id;
+    int next_representation_id;
+    long int next_representation_string_id;
+
+private:
+    std::string directory;
+    bool write_back;
+    std::set<int> changed_representation_ids;
+};
\ No newline at end of file
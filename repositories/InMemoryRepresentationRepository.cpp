@@ -0,0 +1,110 @@
+#include "InMemoryRepresentationRepository.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+
+InMemoryRepresentationRepository::InMemoryRepresentationRepository(InMemoryDatabase& database)
+    : database(database) {}
+
+void InMemoryRepresentationRepository::connect(std::string) {}
+
+void InMemoryRepresentationRepository::connect(pqxx::connection*) {}
+
+void InMemoryRepresentationRepository::disconnect() {}
+
+void InMemoryRepresentationRepository::add(RepresentationDTO object)
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    // внешний ключ на algorithms_data
+    if (!database.algorithms.contains(object.algorithm_id)) {
+        throw std::runtime_error("InMemoryRepresentationRepository::add() unknown algorithm_id");
+    }
+
+    object.representation_id = database.next_representation_id++;
+    object.mark_clean();
+    database.mark_changed_representation(object.representation_id);
+    database.representations.insert_or_assign(object.representation_id, std::move(object));
+}
+
+void InMemoryRepresentationRepository::update(RepresentationDTO object)
+{
+    // как и в RepresentationRepository, записываются только изменённые поля
+    if (!object.is_dirty()) return;
+
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    if (!database.representations.contains(object.representation_id)) return;
+
+    RepresentationDTO& stored = database.representations.at(object.representation_id);
+    if (object.is_dimensionality_dirty()) {
+        stored.dimensionality = object.dimensionality;
+    }
+    if (object.is_iterations_dirty()) {
+        stored.iterations = object.iterations;
+    }
+    stored.mark_clean();
+    database.mark_changed_representation(object.representation_id);
+}
+
+void InMemoryRepresentationRepository::remove(RepresentationDTO object)
+{
+    database.remove_representation(object.representation_id);
+}
+
+std::vector<RepresentationDTO> InMemoryRepresentationRepository::get_all()
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    std::vector<RepresentationDTO> representations_data;
+    representations_data.reserve(database.representations.size());
+    for (const auto& [representation_id, representation] : database.representations) {
+        representations_data.push_back(representation);
+    }
+    std::sort(representations_data.begin(), representations_data.end());
+    return representations_data;
+}
+
+std::optional<RepresentationDTO> InMemoryRepresentationRepository::get_by_id(int id)
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    auto representation = database.representations.find(id);
+    if (representation == database.representations.end()) return std::nullopt;
+    return representation->second;
+}
+
+std::vector<RepresentationDTO> InMemoryRepresentationRepository::get_by_field(const std::string& field, const std::string& value)
+{
+    std::function<bool(const RepresentationDTO&)> predicate;
+    if (field == "representation_id" || field == "algorithm_id" || field == "iterations") {
+        auto number = parse_integer_field_value(value);
+        if (!number.has_value()) return {};
+        int expected = static_cast<int>(number.value());
+        predicate = [&field, expected](const RepresentationDTO& representation) {
+            int actual = field == "representation_id" ? representation.representation_id
+                : field == "algorithm_id" ? representation.algorithm_id
+                : representation.iterations;
+            return actual == expected;
+        };
+    }
+    else if (field == "dimensionality") {
+        auto dimensionality = parse_integer_array_field_value(value);
+        if (!dimensionality.has_value()) return {};
+        predicate = [expected = dimensionality.value()](const RepresentationDTO& representation) {
+            return representation.dimensionality == expected;
+        };
+    }
+    else {
+        return {};
+    }
+
+    std::vector<RepresentationDTO> representations_data;
+    for (const auto& representation : get_all()) {
+        if (predicate(representation)) {
+            representations_data.push_back(representation);
+        }
+    }
+    return representations_data;
+}
\ No newline at end of file
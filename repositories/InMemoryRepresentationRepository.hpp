@@ -0,0 +1,27 @@
+#pragma once
+
+#include "IRepository.hpp"
+#include "InMemoryDatabase.hpp"
+#include "../dto/RepresentationDTO.hpp"
+
+// RepresentationRepository над InMemoryDatabase (без сервера БД)
+class InMemoryRepresentationRepository : public IRepository<RepresentationDTO> {
+public:
+    explicit InMemoryRepresentationRepository(InMemoryDatabase& database);
+
+    // соединения нет, данные уже в InMemoryDatabase
+    void connect(std::string connection) override;
+    void connect(pqxx::connection* connection) override;
+    void disconnect() override;
+
+    void add(RepresentationDTO object) override;
+    void update(RepresentationDTO object) override;
+    void remove(RepresentationDTO object) override;
+
+    std::vector<RepresentationDTO> get_all() override;
+    std::optional<RepresentationDTO> get_by_id(int id) override;
+    std::vector<RepresentationDTO> get_by_field(const std::string& field, const std::string& value) override;
+
+private:
+    InMemoryDatabase& database;
+};
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "InMemoryRepresentationStringRepository.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+InMemoryRepresentationStringRepository::InMemoryRepresentationStringRepository(InMemoryDatabase& database)
+    : database(database) {}
+
+void InMemoryRepresentationStringRepository::connect(std::string) {}
+
+void InMemoryRepresentationStringRepository::connect(pqxx::connection*) {}
+
+void InMemoryRepresentationStringRepository::disconnect() {}
+
+void InMemoryRepresentationStringRepository::add(RepresentationStringDTO object)
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    // внешний ключ на representations_data
+    if (!database.representations.contains(object.representation_id)) {
+        throw std::runtime_error("InMemoryRepresentationStringRepository::add() unknown representation_id");
+    }
+
+    object.representation_string_id = database.next_representation_string_id++;
+    object.mark_clean();
+    database.representation_string_ids[object.representation_id].insert(object.representation_string_id);
+    database.mark_changed_representation(object.representation_id);
+    database.representation_strings.insert_or_assign(object.representation_string_id, std::move(object));
+}
+
+void InMemoryRepresentationStringRepository::update(RepresentationStringDTO object)
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+    update_unlocked(object);
+}
+
+// одна блокировка на всю пачку, как одна транзакция в RepresentationStringRepository::update_many()
+void InMemoryRepresentationStringRepository::update_many(const std::vector<RepresentationStringDTO>& objects)
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+    for (const auto& object : objects) {
+        update_unlocked(object);
+    }
+}
+
+void InMemoryRepresentationStringRepository::update_unlocked(const RepresentationStringDTO& object)
+{
+    // как и в RepresentationStringRepository, записываются только изменённые поля
+    if (!object.is_dirty()) return;
+
+    if (!database.representation_strings.contains(object.representation_string_id)) return;
+
+    RepresentationStringDTO& stored = database.representation_strings.at(object.representation_string_id);
+    if (object.is_content_dirty()) {
+        stored.content = object.content;
+    }
+    if (object.is_validity_dirty()) {
+        stored.validity = object.validity;
+    }
+    stored.mark_clean();
+    database.mark_changed_representation(stored.representation_id);
+}
+
+void InMemoryRepresentationStringRepository::remove(RepresentationStringDTO object)
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    auto representation_string = database.representation_strings.find(object.representation_string_id);
+    if (representation_string == database.representation_strings.end()) return;
+
+    int representation_id = representation_string->second.representation_id;
+    database.representation_string_ids[representation_id].erase(object.representation_string_id);
+    database.representation_strings.erase(representation_string);
+    database.mark_changed_representation(representation_id);
+}
+
+std::vector<RepresentationStringDTO> InMemoryRepresentationStringRepository::get_all()
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    std::vector<RepresentationStringDTO> representation_strings_data;
+    representation_strings_data.reserve(database.representation_strings.size());
+    for (const auto& [representation_string_id, representation_string] : database.representation_strings) {
+        representation_strings_data.push_back(representation_string);
+    }
+    std::sort(representation_strings_data.begin(), representation_strings_data.end());
+    return representation_strings_data;
+}
+
+std::optional<RepresentationStringDTO> InMemoryRepresentationStringRepository::get_by_id(int id)
+{
+    std::lock_guard<std::recursive_mutex> lock(database.mutex);
+
+    auto representation_string = database.representation_strings.find(id);
+    if (representation_string == database.representation_strings.end()) return std::nullopt;
+    return representation_string->second;
+}
+
+std::vector<RepresentationStringDTO> InMemoryRepresentationStringRepository::get_by_field(const std::string& field, const std::string& value)
+{
+    if (field == "representation_string_id" || field == "representation_id") {
+        auto number = parse_integer_field_value(value);
+        if (!number.has_value()) return {};
+
+        if (field == "representation_string_id") {
+            auto representation_string = get_by_id(static_cast<int>(number.value()));
+            if (!representation_string.has_value()) return {};
+            return { representation_string.value() };
+        }
+
+        std::lock_guard<std::recursive_mutex> lock(database.mutex);
+        auto string_ids = database.representation_string_ids.find(static_cast<int>(number.value()));
+        if (string_ids == database.representation_string_ids.end()) return {};
+
+        std::vector<RepresentationStringDTO> representation_strings_data;
+        representation_strings_data.reserve(string_ids->second.size());
+        for (long int representation_string_id : string_ids->second) {
+            representation_strings_data.push_back(database.representation_strings.at(representation_string_id));
+        }
+        return representation_strings_data;
+    }
+    if (field != "content") {
+        return {};
+    }
+
+    auto search_words = InMemoryDatabase::make_search_words(value);
+
+    std::vector<RepresentationStringDTO> representation_strings_data;
+    for (const auto& representation_string : get_all()) {
+        if (InMemoryDatabase::contains_words(representation_string.content, search_words)) {
+            representation_strings_data.push_back(representation_string);
+        }
+    }
+    return representation_strings_data;
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "IRepository.hpp"
+#include "InMemoryDatabase.hpp"
+#include "../dto/RepresentationStringDTO.hpp"
+
+// RepresentationStringRepository над InMemoryDatabase (без сервера БД)
+class InMemoryRepresentationStringRepository : public IRepository<RepresentationStringDTO> {
+public:
+    explicit InMemoryRepresentationStringRepository(InMemoryDatabase& database);
+
+    // соединения нет, данные уже в InMemoryDatabase
+    void connect(std::string connection) override;
+    void connect(pqxx::connection* connection) override;
+    void disconnect() override;
+
+    void add(RepresentationStringDTO object) override;
+    void update(RepresentationStringDTO object) override;
+    void remove(RepresentationStringDTO object) override;
+    void update_many(const std::vector<RepresentationStringDTO>& objects) override;
+
+    std::vector<RepresentationStringDTO> get_all() override;
+    std::optional<RepresentationStringDTO> get_by_id(int id) override;
+    std::vector<RepresentationStringDTO> get_by_field(const std::string& field, const std::string& value) override;
+
+private:
+    InMemoryDatabase& database;
+
+    void update_unlocked(const RepresentationStringDTO& object);
+};
\ No newline at end of file
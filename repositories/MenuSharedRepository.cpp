@@ -1,24 +1,16 @@
 #include "MenuSharedRepository.hpp"
 
-MenuSharedRepository* MenuSharedRepository::instance = nullptr;
-
 MenuSharedRepository::MenuSharedRepository() {}
 
 MenuSharedRepository::~MenuSharedRepository()
 {
     disconnect();
-    delete instance;
 }
 
 void MenuSharedRepository::init()
 {
-    auto pool_en = DataUtils::JsonUtils::read("res/values-en/tui_messages.json");
-    auto pool_ru = DataUtils::JsonUtils::read("res/values-ru/tui_messages.json");
-
+    // тексты языка загружаются при switch_language()
     message_storage = MessageWStorage();
-    pool_en.get_to(message_storage["en"]);
-    pool_ru.get_to(message_storage["ru"]);
-    message_storage.switch_language(Language::Type::Russian);
 }
 
 void MenuSharedRepository::connect()
@@ -31,12 +23,18 @@ void MenuSharedRepository::disconnect()
     message_storage.clear();
 }
 
-MenuSharedRepository& MenuSharedRepository::get_instance()
+void MenuSharedRepository::load_message_overrides(const std::string& file_path)
 {
-    if (!instance) {
-        instance = new MenuSharedRepository();
+    json overrides = DataUtils::JsonUtils::read(file_path);
+    if (overrides.contains("tui_messages")) {
+        message_storage.apply_overrides(overrides["tui_messages"]);
     }
-    return *instance;
+}
+
+MenuSharedRepository& MenuSharedRepository::get_instance()
+{
+    static MenuSharedRepository instance;
+    return instance;
 }
 
 MessageWStorage& MenuSharedRepository::get_message_storage()
@@ -14,13 +14,14 @@ public:
 
     void connect();
     void disconnect();
+    // заменяет тексты меню из раздела "tui_messages" файла переводчика (см. MessageWStorage::apply_overrides)
+    void load_message_overrides(const std::string& file_path);
 
     static MenuSharedRepository& get_instance();
 
     MessageWStorage& get_message_storage();
 
 private:
-    static MenuSharedRepository* instance;
     MessageWStorage message_storage;
 
     void init();
@@ -2,13 +2,19 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
+#include <optional>
+#include <string_view>
+#include <nlohmann/json.hpp>
 #include "../messages/Language.hpp"
 #include "../messages/MessagePool.hpp"
+#include "../messages/MessageTables.hpp"
+#include "../messages/MessageCodes.hpp"
 
 class MessageStorage {
 public:
     MessageStorage() 
-        : language(Language::Type::Unknown) {}
+        : language(Language::Type::Unknown), language_index(0), texts(std::size(MessageTables::languages)) {}
     ~MessageStorage() {}
 
     std::string get_current_pool_name()
@@ -26,9 +32,8 @@ public:
         this->language = language;
         this->language_str = Language::type_to_string(language);
 
-        if (!message_pools.contains(language_str)) {
-            message_pools[language_str] = MessagePool<MessageRecord>();
-        }
+        load_language(language_str);
+        language_index = find_language(language_str).value_or(0);
     }
 
     MessagePool<MessageRecord>& operator[](const std::string& key)
@@ -56,6 +61,63 @@ public:
         message_pools[key] = value;
     }
 
+    // заполняет пулы языка из таблиц, собранных из res/values-*/messages.json (tools/message_tables_generator.cpp):
+    // при запуске не разбирается JSON
+    // загружается только выбранный язык (switch_language), повторный вызов ничего не делает
+    void load_language(const std::string& language_name)
+    {
+        auto language_index = find_language(language_name);
+        if (!language_index.has_value() || !texts[*language_index].empty()) return;
+
+        auto& language_texts = texts[*language_index];
+        language_texts.assign(std::begin(MessageTables::texts[*language_index]), std::end(MessageTables::texts[*language_index]));
+
+        auto& pool = message_pools[language_name];
+        for (size_t pool_index = 0; pool_index < std::size(MessageTables::pools); pool_index++) {
+            auto& record = pool[std::string(MessageTables::pools[pool_index])];
+            for (size_t message_index = 0; message_index < MessageTables::messages[pool_index].size(); message_index++) {
+                record[std::string(MessageTables::messages[pool_index][message_index])] = language_texts[MessageTables::pool_offsets[pool_index] + message_index];
+            }
+        }
+    }
+
+    // замена текстов из файла переводчика, формат как у messages.json с уровнем языка: {"ru": {"other": {"string": "..."}}}
+    // языки, которых нет в каталогах, пропускаются: для них нет исходных текстов
+    void apply_overrides(const nlohmann::json& overrides)
+    {
+        for (const auto& [language_name, pools] : overrides.items()) {
+            auto language_index = find_language(language_name);
+            if (!language_index.has_value()) {
+                std::cerr << "Messages override: unknown language " << language_name << " skipped" << std::endl;
+                continue;
+            }
+            load_language(language_name);
+            auto& language_texts = texts[*language_index];
+
+            auto& pool = message_pools[language_name];
+            for (const auto& [pool_name, records] : pools.items()) {
+                for (const auto& [message_name, text] : records.items()) {
+                    auto code = MessageCodes::find(pool_name, message_name);
+                    if (code.has_value()) {
+                        language_texts[MessageCodes::index(*code)] = text.get<std::string>();
+                    }
+                    pool[pool_name][message_name] = text.get<std::string>();
+                }
+            }
+        }
+    }
+
+    // тексты текущего языка по кодам: индекс в плоской таблице языка вместо поиска по именам пула и сообщения
+    const std::string& get_text(const MessageCode& code) const
+    {
+        return texts[language_index][MessageCodes::index(code)];
+    }
+
+    const std::string& get_text(MessageTables::MessageId id) const
+    {
+        return texts[language_index][static_cast<size_t>(id)];
+    }
+
     void erase(const std::string& key)
     {
         message_pools.erase(key);
@@ -64,6 +126,9 @@ public:
     void clear()
     {
         message_pools.clear();
+        for (auto& language_texts : texts) {
+            language_texts.clear();
+        }
     }
 
     bool contains(const std::string& key) const
@@ -75,4 +140,16 @@ protected:
     Language::Type language;
     std::string language_str;
     tsl::hopscotch_map<std::string, MessagePool<MessageRecord>> message_pools;
+    size_t language_index;                          // текущий язык в MessageTables::languages
+    std::vector<std::vector<std::string>> texts;    // тексты в порядке MessageTables по языкам MessageTables::languages; пусто — язык не загружен
+
+    static std::optional<size_t> find_language(std::string_view language_name)
+    {
+        for (size_t language_index = 0; language_index < std::size(MessageTables::languages); language_index++) {
+            if (MessageTables::languages[language_index] == language_name) {
+                return language_index;
+            }
+        }
+        return std::nullopt;
+    }
 };
\ No newline at end of file
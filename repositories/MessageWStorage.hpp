@@ -2,13 +2,18 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
+#include <optional>
+#include <string_view>
+#include <nlohmann/json.hpp>
 #include "../messages/Language.hpp"
 #include "../messages/MessagePool.hpp"
+#include "../messages/MessageTables.hpp"
 
 class MessageWStorage {
 public:
     MessageWStorage() 
-        : language(Language::Type::Unknown) {}
+        : language(Language::Type::Unknown), language_index(0), texts(std::size(MessageTables::languages)) {}
     ~MessageWStorage() {}
 
     std::string get_current_pool_name()
@@ -26,9 +31,8 @@ public:
         this->language = language;
         this->language_str = Language::type_to_string(language);
 
-        if (!message_pools.contains(language_str)) {
-            message_pools[language_str] = MessagePool<MessageWRecord>();
-        }
+        load_language(language_str);
+        language_index = find_language(language_str).value_or(0);
     }
 
     MessagePool<MessageWRecord>& operator[](const std::string& key)
@@ -56,6 +60,59 @@ public:
         message_pools[key] = value;
     }
 
+    // заполняет пулы языка из таблиц, собранных из res/values-*/tui_messages.json (tools/message_tables_generator.cpp):
+    // при запуске не разбирается JSON и не выполняется преобразование в широкие строки
+    // загружается только выбранный язык (switch_language), повторный вызов ничего не делает
+    void load_language(const std::string& language_name)
+    {
+        auto language_index = find_language(language_name);
+        if (!language_index.has_value() || !texts[*language_index].empty()) return;
+
+        auto& language_texts = texts[*language_index];
+        language_texts.assign(std::begin(MessageTables::tui_wtexts[*language_index]), std::end(MessageTables::tui_wtexts[*language_index]));
+
+        auto& pool = message_pools[language_name];
+        for (size_t pool_index = 0; pool_index < std::size(MessageTables::tui_pools); pool_index++) {
+            auto& record = pool[std::string(MessageTables::tui_pools[pool_index])];
+            for (size_t message_index = 0; message_index < MessageTables::tui_messages[pool_index].size(); message_index++) {
+                record[std::string(MessageTables::tui_messages[pool_index][message_index])] = language_texts[MessageTables::tui_pool_offsets[pool_index] + message_index];
+            }
+        }
+    }
+
+    // замена текстов из файла переводчика, формат как у tui_messages.json с уровнем языка: {"ru": {"main_menu": {"title": "..."}}}
+    // языки, которых нет в каталогах, пропускаются: для них нет исходных текстов
+    void apply_overrides(const nlohmann::json& overrides)
+    {
+        for (const auto& [language_name, pools] : overrides.items()) {
+            auto language_index = find_language(language_name);
+            if (!language_index.has_value()) {
+                std::cerr << "TUI messages override: unknown language " << language_name << " skipped" << std::endl;
+                continue;
+            }
+            load_language(language_name);
+            auto& language_texts = texts[*language_index];
+
+            auto& pool = message_pools[language_name];
+            for (const auto& [pool_name, records] : pools.items()) {
+                for (const auto& [message_name, text] : records.items()) {
+                    std::wstring wide_text = boost::nowide::widen(text.get<std::string>());
+                    auto id = find_id(pool_name, message_name);
+                    if (id.has_value()) {
+                        language_texts[static_cast<size_t>(*id)] = wide_text;
+                    }
+                    pool[pool_name][message_name] = std::move(wide_text);
+                }
+            }
+        }
+    }
+
+    // текст текущего языка по идентификатору сообщения: индекс в плоской таблице
+    const std::wstring& get_text(MessageTables::TuiMessageId id) const
+    {
+        return texts[language_index][static_cast<size_t>(id)];
+    }
+
     void erase(const std::string& key)
     {
         message_pools.erase(key);
@@ -64,6 +121,9 @@ public:
     void clear()
     {
         message_pools.clear();
+        for (auto& language_texts : texts) {
+            language_texts.clear();
+        }
     }
 
     bool contains(const std::string& key) const
@@ -75,4 +135,31 @@ protected:
     Language::Type language;
     std::string language_str;
     tsl::hopscotch_map<std::string, MessagePool<MessageWRecord>> message_pools;
+    size_t language_index;                          // текущий язык в MessageTables::languages
+    std::vector<std::vector<std::wstring>> texts;   // тексты в порядке MessageTables по языкам MessageTables::languages; пусто — язык не загружен
+
+    static std::optional<size_t> find_language(std::string_view language_name)
+    {
+        for (size_t language_index = 0; language_index < std::size(MessageTables::languages); language_index++) {
+            if (MessageTables::languages[language_index] == language_name) {
+                return language_index;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::optional<MessageTables::TuiMessageId> find_id(const std::string& pool_name, const std::string& message_name) const
+    {
+        for (size_t pool_index = 0; pool_index < std::size(MessageTables::tui_pools); pool_index++) {
+            if (MessageTables::tui_pools[pool_index] != pool_name) {
+                continue;
+            }
+            for (size_t message_index = 0; message_index < MessageTables::tui_messages[pool_index].size(); message_index++) {
+                if (MessageTables::tui_messages[pool_index][message_index] == message_name) {
+                    return static_cast<MessageTables::TuiMessageId>(MessageTables::tui_pool_offsets[pool_index] + message_index);
+                }
+            }
+        }
+        return std::nullopt;
+    }
 };
\ No newline at end of file
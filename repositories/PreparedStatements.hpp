@@ -0,0 +1,34 @@
+#pragma once
+
+#include <set>
+#include <span>
+#include <string>
+#include <pqxx/pqxx>
+
+// именованный подготовленный запрос
+// имя должно быть уникально среди всех репозиториев, так как они используют общее соединение
+struct PreparedStatement {
+    const char* name;
+    const char* sql;
+};
+
+namespace PreparedStatements {
+    // регистрирует на соединении запросы каталога, которые ещё не подготовлены
+    // подготовленные запросы живут в рамках сессии, поэтому вызывается при каждом connect()
+    inline void prepare(pqxx::connection& connection, std::span<const PreparedStatement> statements)
+    {
+        std::set<std::string> prepared_names;
+        {
+            pqxx::nontransaction tx(connection);
+            for (auto [name] : tx.query<std::string>("SELECT name FROM pg_prepared_statements;")) {
+                prepared_names.insert(name);
+            }
+        }
+
+        for (const auto& statement : statements) {
+            if (!prepared_names.contains(statement.name)) {
+                connection.prepare(statement.name, statement.sql);
+            }
+        }
+    }
+};
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <stdexcept>
+
+// где хранятся данные репозиториев режима DB
+enum class RepositoryStorage : short {
+    PostgreSQL,     // сервер PostgreSQL (DBConnection)
+    Memory,         // память процесса, начальные данные — из каталога снимков, изменения не сохраняются
+    Snapshot        // память процесса с сохранением изменённых представлений в каталог снимков
+};
+
+inline std::string repository_storage_to_string(RepositoryStorage storage)
+{
+    switch (storage) {
+        case RepositoryStorage::PostgreSQL:
+            return "PostgreSQL";
+        case RepositoryStorage::Memory:
+            return "Memory";
+        case RepositoryStorage::Snapshot:
+            return "Snapshot";
+        default:
+            throw std::invalid_argument("Unknown repository storage");
+    }
+}
+
+inline RepositoryStorage repository_storage_from_string(const std::string& storage)
+{
+    if (storage == "PostgreSQL") {
+        return RepositoryStorage::PostgreSQL;
+    }
+    else if (storage == "Memory") {
+        return RepositoryStorage::Memory;
+    }
+    else if (storage == "Snapshot") {
+        return RepositoryStorage::Snapshot;
+    }
+    else {
+        throw std::invalid_argument("Unknown repository storage");
+    }
+}
\ No newline at end of file
@@ -1,7 +1,57 @@
 #include "RepresentationRepository.hpp"
 
+namespace RepresentationStatements {
+    inline constexpr PreparedStatement add { "representations_add", R"(
+        INSERT INTO representations_data (algorithm_id, dimensionality, iterations) 
+        VALUES ($1, $2, $3);
+    )" };
+    inline constexpr PreparedStatement update { "representations_update", R"(
+        UPDATE representations_data
+        SET dimensionality = $1, iterations = $2
+        WHERE representation_id = $3;
+    )" };
+    inline constexpr PreparedStatement update_dimensionality { "representations_update_dimensionality", R"(
+        UPDATE representations_data
+        SET dimensionality = $1
+        WHERE representation_id = $2;
+    )" };
+    inline constexpr PreparedStatement update_iterations { "representations_update_iterations", R"(
+        UPDATE representations_data
+        SET iterations = $1
+        WHERE representation_id = $2;
+    )" };
+    inline constexpr PreparedStatement remove { "representations_remove", R"(
+        DELETE FROM representations_data
+        WHERE representation_id = $1;
+    )" };
+    inline constexpr PreparedStatement get_all { "representations_get_all", R"(
+        SELECT * FROM representations_data;
+    )" };
+    inline constexpr PreparedStatement get_by_id { "representations_get_by_id", R"(
+        SELECT * FROM representations_data
+        WHERE representation_id = $1;
+    )" };
+    inline constexpr PreparedStatement get_by_algorithm_id { "representations_get_by_algorithm_id", R"(
+        SELECT * FROM representations_data
+        WHERE algorithm_id = $1;
+    )" };
+    inline constexpr PreparedStatement get_by_dimensionality { "representations_get_by_dimensionality", R"(
+        SELECT * FROM representations_data
+        WHERE dimensionality = $1::int[];
+    )" };
+    inline constexpr PreparedStatement get_by_iterations { "representations_get_by_iterations", R"(
+        SELECT * FROM representations_data
+        WHERE iterations = $1;
+    )" };
+
+    inline constexpr PreparedStatement all[] = {
+        add, update, update_dimensionality, update_iterations, remove, get_all, get_by_id,
+        get_by_algorithm_id, get_by_dimensionality, get_by_iterations,
+    };
+};
+
 RepresentationRepository::RepresentationRepository() 
-    : connection(nullptr) {}
+    : connection(nullptr), owns_connection(false) {}
 
 RepresentationRepository::~RepresentationRepository()
 {
@@ -11,41 +61,52 @@ RepresentationRepository::~RepresentationRepository()
 void RepresentationRepository::connect(std::string connection)
 {
     this->connection = new pqxx::connection(connection);
+    this->owns_connection = true;
+    PreparedStatements::prepare(*this->connection, RepresentationStatements::all);
 }
 
 void RepresentationRepository::connect(pqxx::connection* connection)
 {
     this->connection = connection;
+    this->owns_connection = false;
+    PreparedStatements::prepare(*this->connection, RepresentationStatements::all);
 }
 
 void RepresentationRepository::disconnect()
 {
     if (this->connection == nullptr) return;
 
-    delete this->connection;
+    if (this->owns_connection) {
+        delete this->connection;
+    }
     this->connection = nullptr;
+    this->owns_connection = false;
 }
 
 void RepresentationRepository::add(RepresentationDTO object)
 {
     pqxx::work tx(*connection);
 
-    tx.exec(R"(
-        INSERT INTO representations_data (algorithm_id, dimensionality, iterations) 
-        VALUES ($1, $2, $3);
-    )", pqxx::params{object.algorithm_id, object.dimensionality, object.iterations});
+    tx.exec(pqxx::prepped{RepresentationStatements::add.name}, pqxx::params{object.algorithm_id, object.dimensionality, object.iterations});
     tx.commit();
 }
 
 void RepresentationRepository::update(RepresentationDTO object)
 {
+    // записываются только поля, изменённые с момента загрузки
+    if (!object.is_dirty()) return;
+
     pqxx::work tx(*connection);
 
-    tx.exec(R"(
-        UPDATE representations_data
-        SET dimensionality = $1, iterations = $2
-        WHERE representation_id = $3;
-    )", pqxx::params{object.dimensionality, object.iterations, object.representation_id});
+    if (object.is_dimensionality_dirty() && object.is_iterations_dirty()) {
+        tx.exec(pqxx::prepped{RepresentationStatements::update.name}, pqxx::params{object.dimensionality, object.iterations, object.representation_id});
+    }
+    else if (object.is_dimensionality_dirty()) {
+        tx.exec(pqxx::prepped{RepresentationStatements::update_dimensionality.name}, pqxx::params{object.dimensionality, object.representation_id});
+    }
+    else {
+        tx.exec(pqxx::prepped{RepresentationStatements::update_iterations.name}, pqxx::params{object.iterations, object.representation_id});
+    }
     tx.commit();
 }
 
@@ -53,10 +114,7 @@ void RepresentationRepository::remove(RepresentationDTO object)
 {
     pqxx::work tx(*connection);
 
-    tx.exec(R"(
-        DELETE FROM representations_data
-        WHERE representation_id = $1;
-    )", pqxx::params{object.representation_id});
+    tx.exec(pqxx::prepped{RepresentationStatements::remove.name}, pqxx::params{object.representation_id});
     tx.commit();
 }
 
@@ -64,9 +122,7 @@ std::vector<RepresentationDTO> RepresentationRepository::get_all()
 {
     pqxx::work tx(*connection);
 
-    pqxx::result rows = tx.exec(R"(
-        SELECT * FROM representations_data;
-    )");
+    pqxx::result rows = tx.exec(pqxx::prepped{RepresentationStatements::get_all.name});
 
     std::vector<RepresentationDTO> representations_data;
     representations_data.reserve(rows.size());
@@ -78,6 +134,7 @@ std::vector<RepresentationDTO> RepresentationRepository::get_all()
         std::vector<int> dimensionality(dimensionality_arr.cbegin(), dimensionality_arr.cend());
         int iterations = row["iterations"].as<int>();
         RepresentationDTO representation(representation_id, algorithm_id, dimensionality, iterations);
+        representation.mark_clean();
         representations_data.push_back(representation);
     }
 
@@ -88,10 +145,7 @@ std::optional<RepresentationDTO> RepresentationRepository::get_by_id(int id)
 {
     pqxx::work tx(*connection);
 
-    pqxx::result rows = tx.exec(R"(
-        SELECT * FROM representations_data
-        WHERE representation_id = $1;
-    )", pqxx::params{id});
+    pqxx::result rows = tx.exec(pqxx::prepped{RepresentationStatements::get_by_id.name}, pqxx::params{id});
 
     if (rows.empty()) return std::nullopt;
 
@@ -101,18 +155,32 @@ std::optional<RepresentationDTO> RepresentationRepository::get_by_id(int id)
     auto dimensionality_arr = row["dimensionality"].as_sql_array<int>();
     std::vector<int> dimensionality(dimensionality_arr.cbegin(), dimensionality_arr.cend());
     int iterations = row["iterations"].as<int>();
-    return RepresentationDTO(representation_id, algorithm_id, dimensionality, iterations);
+    RepresentationDTO representation(representation_id, algorithm_id, dimensionality, iterations);
+    representation.mark_clean();
+    return representation;
 }
 
 std::vector<RepresentationDTO> RepresentationRepository::get_by_field(const std::string& field, const std::string& value)
 {
     pqxx::work tx(*connection);
 
-    auto regex = make_regex_by_words(value);
-    pqxx::result rows = tx.exec(R"(
-        SELECT * FROM representations_data
-        WHERE $1 ~ $2;
-    )", pqxx::params{field, regex});
+    pqxx::result rows;
+    if (field == "representation_id" || field == "algorithm_id" || field == "iterations") {
+        auto number = parse_integer_field_value(value);
+        if (!number.has_value()) return {};
+        const char* statement_name = field == "representation_id" ? RepresentationStatements::get_by_id.name
+            : field == "algorithm_id" ? RepresentationStatements::get_by_algorithm_id.name
+            : RepresentationStatements::get_by_iterations.name;
+        rows = tx.exec(pqxx::prepped{statement_name}, pqxx::params{static_cast<int>(number.value())});
+    }
+    else if (field == "dimensionality") {
+        auto dimensionality = parse_integer_array_field_value(value);
+        if (!dimensionality.has_value()) return {};
+        rows = tx.exec(pqxx::prepped{RepresentationStatements::get_by_dimensionality.name}, pqxx::params{dimensionality.value()});
+    }
+    else {
+        return {};
+    }
 
     std::vector<RepresentationDTO> representations_data;
     representations_data.reserve(rows.size());
@@ -124,6 +192,7 @@ std::vector<RepresentationDTO> RepresentationRepository::get_by_field(const std:
         std::vector<int> dimensionality(dimensionality_arr.cbegin(), dimensionality_arr.cend());
         int iterations = row["iterations"].as<int>();
         RepresentationDTO representation(representation_id, algorithm_id, dimensionality, iterations);
+        representation.mark_clean();
         representations_data.push_back(representation);
     }
 
@@ -1,7 +1,82 @@
 #include "RepresentationStringRepository.hpp"
 
+namespace RepresentationStringStatements {
+    inline constexpr PreparedStatement add { "representation_strings_add", R"(
+        INSERT INTO representation_strings_data (representation_id, content, validity)
+        VALUES ($1, $2, $3::jsonb);
+    )" };
+    inline constexpr PreparedStatement update { "representation_strings_update", R"(
+        UPDATE representation_strings_data
+        SET content = $1, validity = $2::jsonb
+        WHERE representation_string_id = $3;
+    )" };
+    inline constexpr PreparedStatement update_content { "representation_strings_update_content", R"(
+        UPDATE representation_strings_data
+        SET content = $1
+        WHERE representation_string_id = $2;
+    )" };
+    inline constexpr PreparedStatement update_validity { "representation_strings_update_validity", R"(
+        UPDATE representation_strings_data
+        SET validity = $1::jsonb
+        WHERE representation_string_id = $2;
+    )" };
+    inline constexpr PreparedStatement update_many { "representation_strings_update_many", R"(
+        UPDATE representation_strings_data AS rsd
+        SET content = u.content, validity = u.validity
+        FROM unnest($1::bigint[], $2::text[], $3::jsonb[]) AS u(representation_string_id, content, validity)
+        WHERE rsd.representation_string_id = u.representation_string_id;
+    )" };
+    inline constexpr PreparedStatement update_many_content { "representation_strings_update_many_content", R"(
+        UPDATE representation_strings_data AS rsd
+        SET content = u.content
+        FROM unnest($1::bigint[], $2::text[]) AS u(representation_string_id, content)
+        WHERE rsd.representation_string_id = u.representation_string_id;
+    )" };
+    inline constexpr PreparedStatement update_many_validity { "representation_strings_update_many_validity", R"(
+        UPDATE representation_strings_data AS rsd
+        SET validity = u.validity
+        FROM unnest($1::bigint[], $2::jsonb[]) AS u(representation_string_id, validity)
+        WHERE rsd.representation_string_id = u.representation_string_id;
+    )" };
+    inline constexpr PreparedStatement remove { "representation_strings_remove", R"(
+        DELETE FROM representation_strings_data
+        WHERE representation_string_id = $1;
+    )" };
+    inline constexpr PreparedStatement get_all { "representation_strings_get_all", R"(
+        SELECT * FROM representation_strings_data;
+    )" };
+    inline constexpr PreparedStatement get_by_id { "representation_strings_get_by_id", R"(
+        SELECT * FROM representation_strings_data
+        WHERE representation_string_id = $1;
+    )" };
+    inline constexpr PreparedStatement get_by_ids { "representation_strings_get_by_ids", R"(
+        SELECT * FROM representation_strings_data
+        WHERE representation_string_id = ANY($1::bigint[])
+        ORDER BY representation_string_id;
+    )" };
+    inline constexpr PreparedStatement get_ids_without_validity { "representation_strings_get_ids_without_validity", R"(
+        SELECT representation_string_id FROM representation_strings_data
+        WHERE validity IS NULL
+        ORDER BY representation_string_id;
+    )" };
+    inline constexpr PreparedStatement get_by_representation_id { "representation_strings_get_by_representation_id", R"(
+        SELECT * FROM representation_strings_data
+        WHERE representation_id = $1
+        ORDER BY representation_string_id;
+    )" };
+    inline constexpr PreparedStatement get_by_content { "representation_strings_get_by_content", R"(
+        SELECT * FROM representation_strings_data
+        WHERE content ILIKE ALL($1::text[]);
+    )" };
+
+    inline constexpr PreparedStatement all[] = {
+        add, update, update_content, update_validity, update_many, update_many_content, update_many_validity,
+        remove, get_all, get_by_id, get_by_ids, get_ids_without_validity, get_by_representation_id, get_by_content,
+    };
+};
+
 RepresentationStringRepository::RepresentationStringRepository() 
-    : connection(nullptr) {}
+    : connection(nullptr), owns_connection(false) {}
 
 RepresentationStringRepository::~RepresentationStringRepository()
 {
@@ -11,19 +86,26 @@ RepresentationStringRepository::~RepresentationStringRepository()
 void RepresentationStringRepository::connect(std::string connection)
 {
     this->connection = new pqxx::connection(connection);
+    this->owns_connection = true;
+    PreparedStatements::prepare(*this->connection, RepresentationStringStatements::all);
 }
 
 void RepresentationStringRepository::connect(pqxx::connection* connection)
 {
     this->connection = connection;
+    this->owns_connection = false;
+    PreparedStatements::prepare(*this->connection, RepresentationStringStatements::all);
 }
 
 void RepresentationStringRepository::disconnect()
 {
     if (this->connection == nullptr) return;
 
-    delete this->connection;
+    if (this->owns_connection) {
+        delete this->connection;
+    }
     this->connection = nullptr;
+    this->owns_connection = false;
 }
 
 void RepresentationStringRepository::add(RepresentationStringDTO object)
@@ -32,10 +114,7 @@ void RepresentationStringRepository::add(RepresentationStringDTO object)
 
     auto object_validity = object.validity.has_value() ? std::make_optional(object.validity.value().dump()) : std::nullopt;
     
-    tx.exec(R"(
-        INSERT INTO representation_strings_data (representation_id, content, validity)
-        VALUES ($1, $2, $3::jsonb);
-    )", pqxx::params{
+    tx.exec(pqxx::prepped{RepresentationStringStatements::add.name}, pqxx::params{
         object.representation_id, 
         object.content, 
         object_validity
@@ -45,18 +124,110 @@ void RepresentationStringRepository::add(RepresentationStringDTO object)
 
 void RepresentationStringRepository::update(RepresentationStringDTO object)
 {
+    // записываются только поля, изменённые с момента загрузки
+    if (!object.is_dirty()) return;
+
     pqxx::work tx(*connection);
 
     auto object_validity = object.validity.has_value() ? std::make_optional(object.validity.value().dump()) : std::nullopt;
-    tx.exec(R"(
-        UPDATE representation_strings_data
-        SET content = $1, validity = $2::jsonb
-        WHERE representation_string_id = $3;
-    )", pqxx::params{
-        object.content, 
-        object_validity,
-        object.representation_string_id
-    });
+    if (object.is_content_dirty() && object.is_validity_dirty()) {
+        tx.exec(pqxx::prepped{RepresentationStringStatements::update.name}, pqxx::params{
+            object.content, 
+            object_validity,
+            object.representation_string_id
+        });
+    }
+    else if (object.is_content_dirty()) {
+        tx.exec(pqxx::prepped{RepresentationStringStatements::update_content.name}, pqxx::params{object.content, object.representation_string_id});
+    }
+    else {
+        tx.exec(pqxx::prepped{RepresentationStringStatements::update_validity.name}, pqxx::params{object_validity, object.representation_string_id});
+    }
+    tx.commit();
+}
+
+void RepresentationStringRepository::update_many(const std::vector<RepresentationStringDTO>& objects)
+{
+    // неизменённые строки пропускаются, остальные делятся по набору изменённых столбцов:
+    // после повторной проверки обычно меняется только validity, и content не передаётся в БД
+    std::vector<const RepresentationStringDTO*> full_objects;
+    std::vector<const RepresentationStringDTO*> content_objects;
+    std::vector<const RepresentationStringDTO*> validity_objects;
+
+    for (const auto& object : objects) {
+        bool is_content_dirty = object.is_content_dirty();
+        bool is_validity_dirty = object.is_validity_dirty();
+        if (is_content_dirty && is_validity_dirty) {
+            full_objects.push_back(&object);
+        }
+        else if (is_content_dirty) {
+            content_objects.push_back(&object);
+        }
+        else if (is_validity_dirty) {
+            validity_objects.push_back(&object);
+        }
+    }
+
+    if (full_objects.empty() && content_objects.empty() && validity_objects.empty()) return;
+
+    auto make_validity = [](const RepresentationStringDTO* object) {
+        return object->validity.has_value() ? std::make_optional(object->validity.value().dump()) : std::nullopt;
+    };
+
+    // все строки обновляются в одной транзакции пачками через unnest
+    pqxx::work tx(*connection);
+
+    for (size_t batch_begin = 0; batch_begin < full_objects.size(); batch_begin += update_batch_size) {
+        size_t batch_end = std::min(batch_begin + update_batch_size, full_objects.size());
+
+        std::vector<long int> ids;
+        std::vector<std::string> contents;
+        std::vector<std::optional<std::string>> validities;
+        ids.reserve(batch_end - batch_begin);
+        contents.reserve(batch_end - batch_begin);
+        validities.reserve(batch_end - batch_begin);
+
+        for (size_t i = batch_begin; i < batch_end; i++) {
+            ids.push_back(full_objects[i]->representation_string_id);
+            contents.push_back(full_objects[i]->content);
+            validities.push_back(make_validity(full_objects[i]));
+        }
+
+        tx.exec(pqxx::prepped{RepresentationStringStatements::update_many.name}, pqxx::params{ids, contents, validities});
+    }
+
+    for (size_t batch_begin = 0; batch_begin < content_objects.size(); batch_begin += update_batch_size) {
+        size_t batch_end = std::min(batch_begin + update_batch_size, content_objects.size());
+
+        std::vector<long int> ids;
+        std::vector<std::string> contents;
+        ids.reserve(batch_end - batch_begin);
+        contents.reserve(batch_end - batch_begin);
+
+        for (size_t i = batch_begin; i < batch_end; i++) {
+            ids.push_back(content_objects[i]->representation_string_id);
+            contents.push_back(content_objects[i]->content);
+        }
+
+        tx.exec(pqxx::prepped{RepresentationStringStatements::update_many_content.name}, pqxx::params{ids, contents});
+    }
+
+    for (size_t batch_begin = 0; batch_begin < validity_objects.size(); batch_begin += update_batch_size) {
+        size_t batch_end = std::min(batch_begin + update_batch_size, validity_objects.size());
+
+        std::vector<long int> ids;
+        std::vector<std::optional<std::string>> validities;
+        ids.reserve(batch_end - batch_begin);
+        validities.reserve(batch_end - batch_begin);
+
+        for (size_t i = batch_begin; i < batch_end; i++) {
+            ids.push_back(validity_objects[i]->representation_string_id);
+            validities.push_back(make_validity(validity_objects[i]));
+        }
+
+        tx.exec(pqxx::prepped{RepresentationStringStatements::update_many_validity.name}, pqxx::params{ids, validities});
+    }
+
     tx.commit();
 }
 
@@ -64,10 +235,7 @@ void RepresentationStringRepository::remove(RepresentationStringDTO object)
 {
     pqxx::work tx(*connection);
 
-    tx.exec(R"(
-        DELETE FROM representation_strings_data
-        WHERE representation_string_id = $1;
-    )", pqxx::params{object.representation_string_id});
+    tx.exec(pqxx::prepped{RepresentationStringStatements::remove.name}, pqxx::params{object.representation_string_id});
     tx.commit();
 }
 
@@ -75,9 +243,7 @@ std::vector<RepresentationStringDTO> RepresentationStringRepository::get_all()
 {
     pqxx::work tx(*connection);
 
-    pqxx::result rows = tx.exec(R"(
-        SELECT * FROM representation_strings_data;
-    )");
+    pqxx::result rows = tx.exec(pqxx::prepped{RepresentationStringStatements::get_all.name});
 
     std::vector<RepresentationStringDTO> representation_strings_data;
     representation_strings_data.reserve(rows.size());
@@ -87,6 +253,7 @@ std::vector<RepresentationStringDTO> RepresentationStringRepository::get_all()
         
         auto validity = validity_optional.has_value() ? std::make_optional(json::parse(validity_optional.value())) : std::nullopt;
         RepresentationStringDTO representation_string(representation_string_id, representation_id, content, validity);
+        representation_string.mark_clean();
 
         representation_strings_data.push_back(representation_string);
     }
@@ -98,28 +265,40 @@ std::optional<RepresentationStringDTO> RepresentationStringRepository::get_by_id
 {
     pqxx::work tx(*connection);
 
-    pqxx::result rows = tx.exec(R"(
-        SELECT * FROM representation_strings_data
-        WHERE representation_string_id = $1;
-    )", pqxx::params{id});
+    pqxx::result rows = tx.exec(pqxx::prepped{RepresentationStringStatements::get_by_id.name}, pqxx::params{id});
 
     if (rows.empty()) return std::nullopt;
 
     auto [representation_string_id, representation_id, content, validity_optional] = rows.front().as<int, int, std::string, std::optional<std::string>>();
 
     auto validity = validity_optional.has_value() ? std::make_optional(json::parse(validity_optional.value())) : std::nullopt;
-    return RepresentationStringDTO(representation_string_id, representation_id, content, validity);
+    RepresentationStringDTO representation_string(representation_string_id, representation_id, content, validity);
+    representation_string.mark_clean();
+    return representation_string;
 }
 
 std::vector<RepresentationStringDTO> RepresentationStringRepository::get_by_field(const std::string& field, const std::string& value)
 {
     pqxx::work tx(*connection);
 
-    auto regex = make_regex_by_words(value);
-    pqxx::result rows = tx.exec(R"(
-        SELECT * FROM representation_strings_data
-        WHERE $1 ~* $2;
-    )", pqxx::params{field, regex});
+    pqxx::result rows;
+    if (field == "representation_string_id" || field == "representation_id") {
+        auto number = parse_integer_field_value(value);
+        if (!number.has_value()) return {};
+        if (field == "representation_string_id") {
+            rows = tx.exec(pqxx::prepped{RepresentationStringStatements::get_by_id.name}, pqxx::params{number.value()});
+        }
+        else {
+            rows = tx.exec(pqxx::prepped{RepresentationStringStatements::get_by_representation_id.name}, pqxx::params{static_cast<int>(number.value())});
+        }
+    }
+    else if (field == "content") {
+        auto patterns = make_like_patterns_by_words(value);
+        rows = tx.exec(pqxx::prepped{RepresentationStringStatements::get_by_content.name}, pqxx::params{std::move(patterns)});
+    }
+    else {
+        return {};
+    }
 
     std::vector<RepresentationStringDTO> representation_strings_data;
     representation_strings_data.reserve(rows.size());
@@ -129,8 +308,47 @@ std::vector<RepresentationStringDTO> RepresentationStringRepository::get_by_fiel
         
         auto validity = validity_optional.has_value() ? std::make_optional(json::parse(validity_optional.value())) : std::nullopt;
         RepresentationStringDTO representation_string(representation_string_id, representation_id, content, validity);
+        representation_string.mark_clean();
         representation_strings_data.push_back(representation_string);
     }
 
     return representation_strings_data;
+}
+
+std::vector<RepresentationStringDTO> RepresentationStringRepository::get_by_ids(const std::vector<long int>& ids)
+{
+    if (ids.empty()) return {};
+
+    pqxx::work tx(*connection);
+
+    pqxx::result rows = tx.exec(pqxx::prepped{RepresentationStringStatements::get_by_ids.name}, pqxx::params{ids});
+
+    std::vector<RepresentationStringDTO> representation_strings_data;
+    representation_strings_data.reserve(rows.size());
+
+    for (const auto& row : rows) {
+        auto [representation_string_id, representation_id, content, validity_optional] = row.as<long int, int, std::string, std::optional<std::string>>();
+
+        auto validity = validity_optional.has_value() ? std::make_optional(json::parse(validity_optional.value())) : std::nullopt;
+        RepresentationStringDTO representation_string(representation_string_id, representation_id, content, validity);
+        representation_string.mark_clean();
+        representation_strings_data.push_back(representation_string);
+    }
+
+    return representation_strings_data;
+}
+
+std::vector<long int> RepresentationStringRepository::get_ids_without_validity()
+{
+    pqxx::work tx(*connection);
+
+    pqxx::result rows = tx.exec(pqxx::prepped{RepresentationStringStatements::get_ids_without_validity.name});
+    tx.commit();
+
+    std::vector<long int> representation_string_ids;
+    representation_string_ids.reserve(rows.size());
+    for (const auto& row : rows) {
+        representation_string_ids.push_back(row["representation_string_id"].as<long int>());
+    }
+    return representation_string_ids;
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <pqxx/pqxx>
 
 #include "IRepository.hpp"
+#include "PreparedStatements.hpp"
 #include "../dto/RepresentationStringDTO.hpp"
 
 class RepresentationStringRepository : public IRepository<RepresentationStringDTO> {    
@@ -21,11 +22,21 @@ public:
     void add(RepresentationStringDTO object) override;
     void update(RepresentationStringDTO object) override;
     void remove(RepresentationStringDTO object) override;
+    void update_many(const std::vector<RepresentationStringDTO>& objects) override;
 
     std::vector<RepresentationStringDTO> get_all() override;
     std::optional<RepresentationStringDTO> get_by_id(int id) override;
     std::vector<RepresentationStringDTO> get_by_field(const std::string& field, const std::string& value) override;
+    // строки с указанными идентификаторами по возрастанию representation_string_id, отсутствующие пропускаются
+    std::vector<RepresentationStringDTO> get_by_ids(const std::vector<long int>& ids);
+    // строки без validity (новые или изменённые, см. sql/migrations/002_representation_strings_notify.sql)
+    std::vector<long int> get_ids_without_validity();
 
 private:
+    // количество строк в одном UPDATE ... FROM unnest(...)
+    static constexpr size_t update_batch_size = 10000;
+
     pqxx::connection* connection;
+    // соединение, созданное в connect(std::string), закрывается в disconnect(); переданное извне — нет
+    bool owns_connection;
 };
\ No newline at end of file
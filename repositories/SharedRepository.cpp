@@ -1,12 +1,13 @@
 #include "SharedRepository.hpp"
 
-SharedRepository* SharedRepository::instance;
-
 SharedRepository::SharedRepository() 
-    : connection(nullptr)
-{
-    init();
-}
+    : algorithm_repository(nullptr),
+      representation_repository(nullptr),
+      representation_string_repository(nullptr),
+      algorithm_representation_repository(nullptr),
+      connection(nullptr),
+      owns_connection(false),
+      snapshot_cache_enabled(false) {}
 
 SharedRepository::~SharedRepository()
 {
@@ -15,53 +16,123 @@ SharedRepository::~SharedRepository()
     delete representation_repository;
     delete representation_string_repository;
     delete algorithm_representation_repository;
-    delete instance;
 }
 
-void SharedRepository::init()
+void SharedRepository::create_repositories()
 {
-    algorithm_repository = new AlgorithmRepository();
-    representation_repository = new RepresentationRepository();
-    representation_string_repository = new RepresentationStringRepository();
-    algorithm_representation_repository = new AlgorithmRepresentationRepository();
-
-    auto pool_en = DataUtils::JsonUtils::read("res/values-en/messages.json");
-    auto pool_ru = DataUtils::JsonUtils::read("res/values-ru/messages.json");
-
-    message_storage = MessageStorage();
-    pool_en.get_to(message_storage["en"]);
-    pool_ru.get_to(message_storage["ru"]);
-    message_storage.switch_language(Language::Type::Russian);
+    if (algorithm_repository == nullptr) {
+        replace_repositories(nullptr);
+    }
+}
+
+void SharedRepository::replace_repositories(std::unique_ptr<InMemoryDatabase> database)
+{
+    delete algorithm_repository;
+    delete representation_repository;
+    delete representation_string_repository;
+    delete algorithm_representation_repository;
+
+    // прежние данные в памяти сохраняются в деструкторе InMemoryDatabase
+    in_memory_database = std::move(database);
+    snapshot_cache_enabled = false;
+
+    if (in_memory_database) {
+        algorithm_repository = new InMemoryAlgorithmRepository(*in_memory_database);
+        representation_repository = new InMemoryRepresentationRepository(*in_memory_database);
+        representation_string_repository = new InMemoryRepresentationStringRepository(*in_memory_database);
+        algorithm_representation_repository = new InMemoryAlgorithmRepresentationRepository(*in_memory_database);
+    }
+    else {
+        algorithm_repository = new AlgorithmRepository();
+        representation_repository = new RepresentationRepository();
+        representation_string_repository = new RepresentationStringRepository();
+        algorithm_representation_repository = new AlgorithmRepresentationRepository();
+    }
 }
 
+void SharedRepository::open(RepositoryStorage storage, const std::string& connection, const std::string& directory)
+{
+    if (storage == RepositoryStorage::PostgreSQL) {
+        if (in_memory_database) {
+            disconnect();
+            replace_repositories(nullptr);
+        }
+        connect(connection);
+        return;
+    }
+
+    disconnect();
+    auto database = std::make_unique<InMemoryDatabase>(directory, storage == RepositoryStorage::Snapshot);
+    database->load();
+    replace_repositories(std::move(database));
+}
 
 void SharedRepository::connect(std::string connection)
 {
-    this->connection = new pqxx::connection(connection);
-    connect(this->connection);
+    connect(new pqxx::connection(connection));
+    this->owns_connection = true;
 }
 
 void SharedRepository::connect(pqxx::connection* connection)
 {
+    disconnect();
+    create_repositories();
+    this->connection = connection;
+    this->owns_connection = false;
     algorithm_repository->connect(connection);
     representation_repository->connect(connection);
     representation_string_repository->connect(connection);
     algorithm_representation_repository->connect(connection);
 }
 
+void SharedRepository::enable_snapshot_cache(const std::string& directory)
+{
+    // данные в памяти не требуют кэша
+    if (snapshot_cache_enabled || in_memory_database) return;
+
+    create_repositories();
+    algorithm_representation_repository = new SnapshotCacheRepository(
+        std::unique_ptr<IAlgorithmRepresentationRepository>(algorithm_representation_repository), directory);
+    snapshot_cache_enabled = true;
+
+    if (connection != nullptr) {
+        algorithm_representation_repository->connect(connection);
+    }
+}
+
 void SharedRepository::disconnect() {
-    algorithm_repository->disconnect();
-    representation_repository->disconnect();
-    representation_string_repository->disconnect();
-    algorithm_representation_repository->disconnect();
+    if (in_memory_database) {
+        in_memory_database->save();
+    }
+
+    if (algorithm_repository != nullptr) {
+        algorithm_repository->disconnect();
+        representation_repository->disconnect();
+        representation_string_repository->disconnect();
+        algorithm_representation_repository->disconnect();
+    }
+
+    // репозитории соединение не закрывают, так как получили его извне
+    if (owns_connection) {
+        delete connection;
+    }
+    connection = nullptr;
+    owns_connection = false;
 }
 
 SharedRepository& SharedRepository::get_instance()
 {
-    if (!instance) {
-        instance = new SharedRepository();
+    // инициализация локальной статической переменной потокобезопасна, дальнейшие вызовы идут без блокировок
+    static SharedRepository instance;
+    return instance;
+}
+
+void SharedRepository::load_message_overrides(const std::string& file_path)
+{
+    json overrides = DataUtils::JsonUtils::read(file_path);
+    if (overrides.contains("messages")) {
+        message_storage.apply_overrides(overrides["messages"]);
     }
-    return *instance;
 }
 
 MessageStorage& SharedRepository::get_message_storage()
@@ -71,20 +142,24 @@ MessageStorage& SharedRepository::get_message_storage()
 
 IRepository<AlgorithmDTO>& SharedRepository::get_algorithm_repository()
 {
+    create_repositories();
     return *algorithm_repository;
 }
 
 IRepository<RepresentationDTO>& SharedRepository::get_representation_repository()
 {
+    create_repositories();
     return *representation_repository;
 }
 
 IRepository<RepresentationStringDTO>& SharedRepository::get_representation_string_repository()
 {
+    create_repositories();
     return *representation_string_repository;
 }
 
-IRepository<AlgorithmRepresentation>& SharedRepository::get_algorithm_representation_repository()
+IAlgorithmRepresentationRepository& SharedRepository::get_algorithm_representation_repository()
 {
+    create_repositories();
     return *algorithm_representation_repository;
 }
\ No newline at end of file
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 #include <pqxx/pqxx>
 
 #include "IRepository.hpp"
+#include "IAlgorithmRepresentationRepository.hpp"
 #include "../dto/AlgorithmDTO.hpp"
 #include "../dto/RepresentationDTO.hpp"
 #include "../dto/RepresentationStringDTO.hpp"
@@ -11,12 +13,21 @@
 #include "RepresentationRepository.hpp"
 #include "RepresentationStringRepository.hpp"
 #include "AlgorithmRepresentationRepository.hpp"
+#include "SnapshotCacheRepository.hpp"
+#include "RepositoryStorage.hpp"
+#include "InMemoryDatabase.hpp"
+#include "InMemoryAlgorithmRepository.hpp"
+#include "InMemoryRepresentationRepository.hpp"
+#include "InMemoryRepresentationStringRepository.hpp"
+#include "InMemoryAlgorithmRepresentationRepository.hpp"
 #include "MessageStorage.hpp"
 #include "../messages/MessagePool.hpp"
 #include "../utils/DataUtils.hpp"
 
 // синглтон
 // фасад для репозиториев
+// репозитории создаются при первом подключении или обращении к ним, каталог сообщений загружается
+// только для языка, выбранного через get_message_storage().switch_language(), поэтому режим File их не создаёт
 class SharedRepository {
 public:
     SharedRepository();
@@ -27,24 +38,37 @@ public:
     void connect(std::string connection);
     void connect(pqxx::connection* connection);
     void disconnect();
+    // подключение к хранилищу из настроек: PostgreSQL — по строке connection,
+    // Memory и Snapshot — репозитории InMemory* над каталогом снимков directory
+    void open(RepositoryStorage storage, const std::string& connection, const std::string& directory);
+    // оборачивает репозиторий представлений в SnapshotCacheRepository; повторный вызов ничего не меняет
+    void enable_snapshot_cache(const std::string& directory);
+    // заменяет тексты сообщений из раздела "messages" файла переводчика (см. MessageStorage::apply_overrides)
+    void load_message_overrides(const std::string& file_path);
 
     static SharedRepository& get_instance();
     MessageStorage& get_message_storage();
     IRepository<AlgorithmDTO>& get_algorithm_repository();
     IRepository<RepresentationDTO>& get_representation_repository();
     IRepository<RepresentationStringDTO>& get_representation_string_repository();
-    IRepository<AlgorithmRepresentation>& get_algorithm_representation_repository();
+    IAlgorithmRepresentationRepository& get_algorithm_representation_repository();
 
 private:
-    static SharedRepository* instance;
     IRepository<AlgorithmDTO>* algorithm_repository;
     IRepository<RepresentationDTO>* representation_repository;
     IRepository<RepresentationStringDTO>* representation_string_repository;
-    IRepository<AlgorithmRepresentation>* algorithm_representation_repository;
+    IAlgorithmRepresentationRepository* algorithm_representation_repository;
 
     MessageStorage message_storage;
 
     pqxx::connection *connection;
+    bool owns_connection;
+    bool snapshot_cache_enabled;
+    // данные хранилищ Memory и Snapshot, nullptr для PostgreSQL
+    std::unique_ptr<InMemoryDatabase> in_memory_database;
 
-    void init();
+    // создаёт репозитории PostgreSQL, если они ещё не созданы
+    void create_repositories();
+    // пересоздаёт репозитории: над database или, если он пуст, над PostgreSQL
+    void replace_repositories(std::unique_ptr<InMemoryDatabase> database);
 };
\ No newline at end of file
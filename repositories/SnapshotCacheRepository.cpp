@@ -0,0 +1,227 @@
+#include "SnapshotCacheRepository.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+
+namespace SnapshotCacheStatements {
+    // версия меняется при любом изменении строки алгоритма, представления или его строк (новый xmin),
+    // а также при добавлении и удалении строк представления (count)
+    inline constexpr PreparedStatement get_source_versions { "snapshot_cache_get_source_versions", R"(
+        SELECT
+            rd.representation_id AS representation_id,
+            ad.xmin::text || ':' || rd.xmin::text || ':'
+                || count(rsd.representation_string_id)::text || ':'
+                || coalesce(max(rsd.xmin::text::bigint), 0)::text AS source_version
+        FROM main.representations_data rd
+        JOIN main.algorithms_data ad
+            ON ad.algorithm_id = rd.algorithm_id
+        LEFT JOIN main.representation_strings_data rsd
+            ON rsd.representation_id = rd.representation_id
+        WHERE rd.representation_id = ANY($1::int[])
+        GROUP BY rd.representation_id, ad.xmin::text, rd.xmin::text;
+    )" };
+
+    inline constexpr PreparedStatement all[] = {
+        get_source_versions,
+    };
+};
+
+SnapshotCacheRepository::SnapshotCacheRepository(std::unique_ptr<IAlgorithmRepresentationRepository> repository, const std::string& directory)
+    : repository(std::move(repository)),
+      directory(directory),
+      connection(nullptr),
+      owns_connection(false)
+{
+    std::filesystem::create_directories(directory);
+}
+
+SnapshotCacheRepository::~SnapshotCacheRepository()
+{
+    disconnect();
+}
+
+void SnapshotCacheRepository::connect(std::string connection)
+{
+    connect(new pqxx::connection(connection));
+    this->owns_connection = true;
+}
+
+void SnapshotCacheRepository::connect(pqxx::connection* connection)
+{
+    this->connection = connection;
+    this->owns_connection = false;
+    PreparedStatements::prepare(*this->connection, SnapshotCacheStatements::all);
+    repository->connect(connection);
+}
+
+void SnapshotCacheRepository::disconnect()
+{
+    if (connection == nullptr) return;
+
+    repository->disconnect();
+    if (owns_connection) {
+        delete connection;
+    }
+    connection = nullptr;
+    owns_connection = false;
+}
+
+void SnapshotCacheRepository::add(AlgorithmRepresentation object)
+{
+    repository->add(std::move(object));
+}
+
+void SnapshotCacheRepository::update(AlgorithmRepresentation object)
+{
+    if (!object.is_dirty()) return;
+
+    repository->update(object);
+
+    // после записи снимок устарел по версии; сохраняем записанное состояние с новой версией,
+    // чтобы следующая загрузка не шла в БД
+    object.mark_clean();
+    store({ object });
+}
+
+void SnapshotCacheRepository::remove(AlgorithmRepresentation object)
+{
+    int representation_id = object.representation.representation_id;
+    repository->remove(std::move(object));
+
+    std::error_code error;
+    std::filesystem::remove(get_file_path(representation_id), error);
+}
+
+std::vector<AlgorithmRepresentation> SnapshotCacheRepository::get_all()
+{
+    return repository->get_all();
+}
+
+std::optional<AlgorithmRepresentation> SnapshotCacheRepository::get_by_id(int id)
+{
+    auto algorithms_representations = load({ id }, nullptr);
+    if (algorithms_representations.empty()) return std::nullopt;
+    return std::move(algorithms_representations.front());
+}
+
+std::vector<AlgorithmRepresentation> SnapshotCacheRepository::get_by_field(const std::string& field, const std::string& value)
+{
+    return repository->get_by_field(field, value);
+}
+
+std::vector<AlgorithmRepresentation> SnapshotCacheRepository::get_by_filter(const AlgorithmRepresentationFilter& filter)
+{
+    return load(repository->get_ids_by_filter(filter), &filter);
+}
+
+std::vector<int> SnapshotCacheRepository::get_ids_by_filter(const AlgorithmRepresentationFilter& filter)
+{
+    return repository->get_ids_by_filter(filter);
+}
+
+void SnapshotCacheRepository::for_each(const std::function<void(AlgorithmRepresentation&&)>& callback)
+{
+    repository->for_each(callback);
+}
+
+void SnapshotCacheRepository::store(const std::vector<AlgorithmRepresentation>& objects)
+{
+    std::vector<int> representation_ids;
+    representation_ids.reserve(objects.size());
+    for (const auto& object : objects) {
+        representation_ids.push_back(object.representation.representation_id);
+    }
+
+    auto source_versions = get_source_versions(representation_ids);
+    for (const auto& object : objects) {
+        int representation_id = object.representation.representation_id;
+        auto source_version = source_versions.find(representation_id);
+        if (source_version == source_versions.end()) {
+            std::error_code error;
+            std::filesystem::remove(get_file_path(representation_id), error);
+            continue;
+        }
+        save(object, source_version->second);
+    }
+}
+
+std::string SnapshotCacheRepository::get_file_path(int representation_id) const
+{
+    return (std::filesystem::path(directory) / RepresentationSnapshot::file_name(representation_id)).string();
+}
+
+std::map<int, std::string> SnapshotCacheRepository::get_source_versions(const std::vector<int>& representation_ids)
+{
+    std::map<int, std::string> source_versions;
+    if (connection == nullptr || representation_ids.empty()) return source_versions;
+
+    pqxx::work tx(*connection);
+    pqxx::result rows = tx.exec(pqxx::prepped{SnapshotCacheStatements::get_source_versions.name}, pqxx::params{representation_ids});
+    tx.commit();
+
+    for (const auto& row : rows) {
+        source_versions.emplace(row["representation_id"].as<int>(), row["source_version"].as<std::string>());
+    }
+    return source_versions;
+}
+
+// версия читается до загрузки представления: если оно изменится между запросами,
+// снимок получит более старую версию и будет перезагружен при следующем обращении
+std::vector<AlgorithmRepresentation> SnapshotCacheRepository::load(const std::vector<int>& representation_ids, const AlgorithmRepresentationFilter* filter)
+{
+    auto source_versions = get_source_versions(representation_ids);
+
+    std::vector<std::optional<AlgorithmRepresentation>> loaded(representation_ids.size());
+    std::vector<size_t> missed_indexes;
+    for (size_t i = 0; i < representation_ids.size(); i++) {
+        auto source_version = source_versions.find(representation_ids[i]);
+        if (source_version == source_versions.end()) continue;
+
+        loaded[i] = RepresentationSnapshot::read(get_file_path(representation_ids[i]), source_version->second);
+        if (!loaded[i].has_value()) {
+            missed_indexes.push_back(i);
+        }
+    }
+
+    if (filter != nullptr && missed_indexes.size() == representation_ids.size() && !missed_indexes.empty()) {
+        // холодный кэш: одна выборка по фильтру дешевле, чем загрузка каждого представления по отдельности
+        for (auto& algorithm_representation : repository->get_by_filter(*filter)) {
+            auto position = std::find(representation_ids.begin(), representation_ids.end(), algorithm_representation.representation.representation_id);
+            if (position == representation_ids.end()) continue;
+
+            size_t index = position - representation_ids.begin();
+            save(algorithm_representation, source_versions[representation_ids[index]]);
+            loaded[index] = std::move(algorithm_representation);
+        }
+    }
+    else {
+        for (size_t index : missed_indexes) {
+            loaded[index] = repository->get_by_id(representation_ids[index]);
+            if (loaded[index].has_value()) {
+                save(loaded[index].value(), source_versions[representation_ids[index]]);
+            }
+        }
+    }
+
+    std::vector<AlgorithmRepresentation> algorithms_representations;
+    algorithms_representations.reserve(loaded.size());
+    for (auto& algorithm_representation : loaded) {
+        // представления без строк репозиторий не возвращает, из снимка тоже не отдаём
+        if (algorithm_representation.has_value() && !algorithm_representation->representation_strings.empty()) {
+            algorithms_representations.push_back(std::move(algorithm_representation.value()));
+        }
+    }
+    return algorithms_representations;
+}
+
+void SnapshotCacheRepository::save(const AlgorithmRepresentation& algorithm_representation, const std::string& source_version)
+{
+    // недоступный каталог кэша не должен мешать загрузке из БД
+    try {
+        RepresentationSnapshot::write(get_file_path(algorithm_representation.representation.representation_id), algorithm_representation, source_version);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "SnapshotCacheRepository: " << e.what() << std::endl;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <pqxx/pqxx>
+
+#include "IAlgorithmRepresentationRepository.hpp"
+#include "PreparedStatements.hpp"
+#include "../dto/AlgorithmRepresentation.hpp"
+#include "../dto/AlgorithmRepresentationFilter.hpp"
+#include "../utils/RepresentationSnapshot.hpp"
+
+// кэш представлений на диске поверх другого репозитория (read-through)
+// снимок представления хранится в файле <directory>/representation_<representation_id>.qds вместе с версией источника,
+// собранной из xmin строк таблиц; повторная загрузка неизменённого представления стоит одного короткого запроса
+// массовые обходы (get_all(), for_each(), get_by_field()) идут напрямую во вложенный репозиторий
+class SnapshotCacheRepository : public IAlgorithmRepresentationRepository {
+public:
+    SnapshotCacheRepository(std::unique_ptr<IAlgorithmRepresentationRepository> repository, const std::string& directory);
+    ~SnapshotCacheRepository();
+
+    void connect(std::string connection) override;
+    void connect(pqxx::connection* connection) override;
+    void disconnect() override;
+
+    void add(AlgorithmRepresentation object) override;
+    void update(AlgorithmRepresentation object) override;
+    void remove(AlgorithmRepresentation object) override;
+
+    std::vector<AlgorithmRepresentation> get_all() override;
+    std::optional<AlgorithmRepresentation> get_by_id(int id) override;
+    std::vector<AlgorithmRepresentation> get_by_field(const std::string& field, const std::string& value) override;
+    std::vector<AlgorithmRepresentation> get_by_filter(const AlgorithmRepresentationFilter& filter) override;
+    std::vector<int> get_ids_by_filter(const AlgorithmRepresentationFilter& filter) override;
+    void for_each(const std::function<void(AlgorithmRepresentation&&)>& callback) override;
+
+    // записывает снимки уже сохранённых в БД представлений с их текущей версией источника
+    void store(const std::vector<AlgorithmRepresentation>& objects);
+
+private:
+    std::unique_ptr<IAlgorithmRepresentationRepository> repository;
+    std::string directory;
+    pqxx::connection* connection;
+    bool owns_connection;
+
+    std::string get_file_path(int representation_id) const;
+    // representation_id -> версия источника; отсутствующих в БД представлений в результате нет
+    std::map<int, std::string> get_source_versions(const std::vector<int>& representation_ids);
+    std::vector<AlgorithmRepresentation> load(const std::vector<int>& representation_ids, const AlgorithmRepresentationFilter* filter);
+    void save(const AlgorithmRepresentation& algorithm_representation, const std::string& source_version);
+};
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include "WriteBehindQueue.hpp"
+
+#include <memory>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "AlgorithmRepository.hpp"
+#include "RepresentationRepository.hpp"
+#include "RepresentationStringRepository.hpp"
+#include "AlgorithmRepresentationRepository.hpp"
+#include "SnapshotCacheRepository.hpp"
+
+WriteBehindQueue::WriteBehindQueue(size_t max_depth, size_t max_batch_size)
+    : max_depth(std::max<size_t>(max_depth, 1)),
+      max_batch_size(std::max<size_t>(max_batch_size, 1)),
+      max_write_attempts(1),
+      connection(nullptr),
+      owns_connection(false),
+      in_flight_count(0),
+      is_stopping(false) {}
+
+WriteBehindQueue::~WriteBehindQueue()
+{
+    try {
+        disconnect();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "WriteBehindQueue: " << e.what() << std::endl;
+    }
+}
+
+void WriteBehindQueue::connect(std::string connection)
+{
+    connect(new pqxx::connection(connection));
+    this->owns_connection = true;
+}
+
+void WriteBehindQueue::connect(pqxx::connection* connection)
+{
+    disconnect();
+    this->connection = connection;
+    this->owns_connection = false;
+    this->is_stopping = false;
+    this->error = nullptr;
+    writer = std::thread(&WriteBehindQueue::run, this);
+}
+
+void WriteBehindQueue::disconnect()
+{
+    if (connection == nullptr) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        is_stopping = true;
+    }
+    queue_changed.notify_all();
+    writer.join();
+
+    if (owns_connection) {
+        delete connection;
+    }
+    connection = nullptr;
+    owns_connection = false;
+
+    if (error) {
+        std::rethrow_exception(std::exchange(error, nullptr));
+    }
+}
+
+void WriteBehindQueue::set_snapshot_cache_directory(const std::string& directory)
+{
+    this->snapshot_cache_directory = directory;
+}
+
+void WriteBehindQueue::set_written_callback(std::function<void(const std::vector<AlgorithmRepresentation>&)> callback)
+{
+    this->written_callback = std::move(callback);
+}
+
+void WriteBehindQueue::set_reconnect(std::function<pqxx::connection*()> reconnect, size_t max_attempts)
+{
+    this->reconnect = std::move(reconnect);
+    this->max_write_attempts = std::max<size_t>(max_attempts, 1);
+}
+
+void WriteBehindQueue::push(AlgorithmRepresentation object)
+{
+    if (!writer.joinable()) {
+        throw std::runtime_error("WriteBehindQueue::push() called before connect()");
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        queue_changed.wait(lock, [this]() { return queue.size() < max_depth || error; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        queue.push_back(std::move(object));
+    }
+    queue_changed.notify_all();
+}
+
+void WriteBehindQueue::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    queue_changed.wait(lock, [this]() { return (queue.empty() && in_flight_count == 0) || error; });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void WriteBehindQueue::run()
+{
+    try {
+        AlgorithmRepository algorithm_repository;
+        RepresentationRepository representation_repository;
+        RepresentationStringRepository representation_string_repository;
+        algorithm_repository.connect(connection);
+        representation_repository.connect(connection);
+        representation_string_repository.connect(connection);
+
+        std::unique_ptr<SnapshotCacheRepository> snapshot_repository;
+        if (!snapshot_cache_directory.empty()) {
+            snapshot_repository = std::make_unique<SnapshotCacheRepository>(
+                std::make_unique<AlgorithmRepresentationRepository>(algorithm_repository, representation_repository, representation_string_repository),
+                snapshot_cache_directory);
+            snapshot_repository->connect(connection);
+        }
+
+        while (true) {
+            std::vector<AlgorithmRepresentation> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                queue_changed.wait(lock, [this]() { return is_stopping || !queue.empty(); });
+                if (queue.empty()) {
+                    break;
+                }
+                while (!queue.empty() && batch.size() < max_batch_size) {
+                    batch.push_back(std::move(queue.front()));
+                    queue.pop_front();
+                }
+                in_flight_count = batch.size();
+            }
+            queue_changed.notify_all();
+
+            // строки всех представлений пачки записываются одним update_many();
+            // запись идемпотентна, поэтому после разрыва соединения пачка повторяется целиком
+            for (size_t attempt = 1; ; attempt++) {
+                try {
+                    std::vector<RepresentationStringDTO> representation_strings;
+                    for (const auto& object : batch) {
+                        algorithm_repository.update(object.algorithm);
+                        representation_repository.update(object.representation);
+                        representation_strings.insert(representation_strings.end(), object.representation_strings.begin(), object.representation_strings.end());
+                    }
+                    representation_string_repository.update_many(representation_strings);
+
+                    if (snapshot_repository) {
+                        snapshot_repository->store(batch);
+                    }
+                    break;
+                }
+                catch (const pqxx::broken_connection&) {
+                    if (!reconnect || attempt >= max_write_attempts) {
+                        throw;
+                    }
+                    connection = reconnect();
+                    algorithm_repository.connect(connection);
+                    representation_repository.connect(connection);
+                    representation_string_repository.connect(connection);
+                    if (snapshot_repository) {
+                        snapshot_repository->connect(connection);
+                    }
+                }
+            }
+
+            if (written_callback) {
+                written_callback(batch);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                in_flight_count = 0;
+            }
+            queue_changed.notify_all();
+        }
+    }
+    catch (...) {
+        // непринятые представления отбрасываются, ошибку получит следующий push() или flush()
+        std::lock_guard<std::mutex> lock(mutex);
+        error = std::current_exception();
+        queue.clear();
+        in_flight_count = 0;
+    }
+    queue_changed.notify_all();
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <thread>
+#include <functional>
+#include <exception>
+#include <condition_variable>
+#include <pqxx/pqxx>
+
+#include "../dto/AlgorithmRepresentation.hpp"
+
+// отложенная запись проверенных представлений в БД
+// представления ставятся в очередь, а фоновый поток на собственном соединении записывает их пачками,
+// объединяя строки нескольких представлений в один update_many(); проверка следующего представления
+// тем временем продолжается. при заполненной очереди push() ждёт, ошибка записи пробрасывается из push()/flush()
+class WriteBehindQueue {
+public:
+    WriteBehindQueue(size_t max_depth, size_t max_batch_size = 32);
+    ~WriteBehindQueue();
+    WriteBehindQueue(const WriteBehindQueue&) = delete;
+    WriteBehindQueue& operator=(const WriteBehindQueue&) = delete;
+
+    // соединение используется только фоновым потоком, до disconnect() обращаться к нему нельзя
+    void connect(std::string connection);
+    void connect(pqxx::connection* connection);
+    // дожидается записи всей очереди и останавливает фоновый поток
+    void disconnect();
+
+    // после записи обновляются снимки представлений (SnapshotCacheRepository), вызывается до connect()
+    void set_snapshot_cache_directory(const std::string& directory);
+    // вызывается фоновым потоком после записи каждой пачки
+    void set_written_callback(std::function<void(const std::vector<AlgorithmRepresentation>&)> callback);
+    // при pqxx::broken_connection пачка записывается повторно на соединении, которое вернёт reconnect
+    // (соединением владеет вызывающий), без него ошибка сразу пробрасывается из push()/flush()
+    void set_reconnect(std::function<pqxx::connection*()> reconnect, size_t max_attempts = 3);
+
+    void push(AlgorithmRepresentation object);
+    void flush();
+
+private:
+    size_t max_depth;
+    size_t max_batch_size;
+    std::string snapshot_cache_directory;
+    std::function<void(const std::vector<AlgorithmRepresentation>&)> written_callback;
+    std::function<pqxx::connection*()> reconnect;
+    size_t max_write_attempts;
+
+    pqxx::connection* connection;
+    bool owns_connection;
+
+    std::deque<AlgorithmRepresentation> queue;
+    size_t in_flight_count;
+    bool is_stopping;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable queue_changed;
+    std::thread writer;
+
+    void run();
+};
\ No newline at end of file
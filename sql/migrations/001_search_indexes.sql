@@ -0,0 +1,23 @@
+-- Индексы для поиска в get_by_field() и get_by_filter().
+-- Названия и описания ищутся по словам (ILIKE ALL '%слово%') на языке сессии main.lang();
+-- запросы дополнительно проверяют выражение по обоим языкам, по которому построен триграммный GIN-индекс,
+-- поэтому с миграцией таблица не сканируется целиком, а без неё запросы работают так же, только медленнее.
+
+CREATE EXTENSION IF NOT EXISTS pg_trgm;
+
+CREATE INDEX IF NOT EXISTS algorithms_data_name_trgm_idx
+    ON main.algorithms_data USING gin ((coalesce(name->>'en', '') || ' ' || coalesce(name->>'ru', '')) gin_trgm_ops);
+
+CREATE INDEX IF NOT EXISTS algorithms_data_description_trgm_idx
+    ON main.algorithms_data USING gin ((coalesce(description->>'en', '') || ' ' || coalesce(description->>'ru', '')) gin_trgm_ops);
+
+-- выборка представлений алгоритма и строк представления (get_by_filter, load_representation_strings, for_each)
+CREATE INDEX IF NOT EXISTS representations_data_algorithm_id_idx
+    ON main.representations_data (algorithm_id);
+
+CREATE INDEX IF NOT EXISTS representation_strings_data_representation_id_idx
+    ON main.representation_strings_data (representation_id, representation_string_id);
+
+ANALYZE main.algorithms_data;
+ANALYZE main.representations_data;
+ANALYZE main.representation_strings_data;
@@ -0,0 +1,50 @@
+-- Уведомления об изменении строк представлений для режима Listen (NotificationWorker).
+-- При добавлении строки или изменении её content в канал representation_strings_changed
+-- отправляется representation_string_id; запись validity уведомлений не вызывает,
+-- поэтому результаты самого обработчика не запускают повторную проверку.
+-- Одинаковые уведомления в пределах транзакции PostgreSQL объединяет сам.
+-- Уведомления, отправленные без слушателя, теряются, поэтому изменение content без новой validity
+-- сбрасывает validity в NULL: при запуске обработчик проверяет все строки без validity.
+-- Проверка на локальном сервере: запустить обработчик с --work-mode DB --listen --idle-timeout 10,
+-- выполнить UPDATE main.representation_strings_data SET content = ... и дождаться новой validity.
+
+CREATE OR REPLACE FUNCTION main.reset_representation_string_validity()
+    RETURNS trigger
+    LANGUAGE plpgsql
+AS $$
+BEGIN
+    NEW.validity := NULL;
+    RETURN NEW;
+END;
+$$;
+
+CREATE OR REPLACE FUNCTION main.notify_representation_string_changed()
+    RETURNS trigger
+    LANGUAGE plpgsql
+AS $$
+BEGIN
+    PERFORM pg_notify('representation_strings_changed', NEW.representation_string_id::text);
+    RETURN NULL;
+END;
+$$;
+
+DROP TRIGGER IF EXISTS representation_strings_data_insert_notify ON main.representation_strings_data;
+CREATE TRIGGER representation_strings_data_insert_notify
+    AFTER INSERT ON main.representation_strings_data
+    FOR EACH ROW
+    EXECUTE FUNCTION main.notify_representation_string_changed();
+
+DROP TRIGGER IF EXISTS representation_strings_data_content_notify ON main.representation_strings_data;
+CREATE TRIGGER representation_strings_data_content_notify
+    AFTER UPDATE OF content ON main.representation_strings_data
+    FOR EACH ROW
+    WHEN (OLD.content IS DISTINCT FROM NEW.content)
+    EXECUTE FUNCTION main.notify_representation_string_changed();
+
+-- validity, записанная той же командой вместе с content, сохраняется
+DROP TRIGGER IF EXISTS representation_strings_data_content_reset_validity ON main.representation_strings_data;
+CREATE TRIGGER representation_strings_data_content_reset_validity
+    BEFORE UPDATE OF content ON main.representation_strings_data
+    FOR EACH ROW
+    WHEN (OLD.content IS DISTINCT FROM NEW.content AND OLD.validity IS NOT DISTINCT FROM NEW.validity)
+    EXECUTE FUNCTION main.reset_representation_string_validity();
\ No newline at end of file
@@ -0,0 +1,222 @@
+// генератор messages/MessageTables.hpp из каталогов сообщений res/values-*/messages.json и tui_messages.json
+// запускается из корня репозитория после любого изменения каталогов:
+//   g++ -std=c++20 tools/message_tables_generator.cpp -o message_tables_generator
+//   ./message_tables_generator res messages/MessageTables.hpp
+// порядок пулов и сообщений берётся из английского каталога и задаёт коды MessageCode, которые хранятся в БД,
+// поэтому новые пулы и сообщения добавляются только в конец; каталоги других языков должны содержать те же ключи
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+
+using ordered_json = nlohmann::ordered_json;
+
+struct Pool {
+    std::string name;
+    std::vector<std::string> keys;
+};
+
+struct Catalogue {
+    std::string file_name;                          // имя файла в каталоге values-<язык>
+    std::string prefix;                             // префикс имён в MessageTables
+    std::vector<Pool> pools;
+    std::vector<std::vector<std::string>> texts;    // [язык][номер сообщения]
+};
+
+static ordered_json read_json(const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open " + path.string());
+    }
+    return ordered_json::parse(file);
+}
+
+static std::vector<std::string> find_languages(const std::filesystem::path& resources_directory)
+{
+    std::vector<std::string> languages;
+    for (const auto& entry : std::filesystem::directory_iterator(resources_directory)) {
+        std::string name = entry.path().filename().string();
+        if (entry.is_directory() && name.starts_with("values-")) {
+            languages.push_back(name.substr(std::string("values-").size()));
+        }
+    }
+    std::sort(languages.begin(), languages.end());
+
+    // английский каталог задаёт порядок, поэтому идёт первым
+    auto it = std::find(languages.begin(), languages.end(), "en");
+    if (it == languages.end()) {
+        throw std::runtime_error("res/values-en is required");
+    }
+    std::rotate(languages.begin(), it, it + 1);
+    return languages;
+}
+
+static void read_catalogue(const std::filesystem::path& resources_directory, const std::vector<std::string>& languages, Catalogue& catalogue)
+{
+    ordered_json reference = read_json(resources_directory / "values-en" / catalogue.file_name);
+    for (const auto& [pool_name, pool_messages] : reference.items()) {
+        Pool pool { pool_name, {} };
+        for (const auto& [key, text] : pool_messages.items()) {
+            pool.keys.push_back(key);
+        }
+        catalogue.pools.push_back(std::move(pool));
+    }
+
+    for (const auto& language : languages) {
+        ordered_json messages = read_json(resources_directory / ("values-" + language) / catalogue.file_name);
+        std::vector<std::string> texts;
+        for (const auto& pool : catalogue.pools) {
+            for (const auto& key : pool.keys) {
+                if (!messages.contains(pool.name) || !messages[pool.name].contains(key)) {
+                    throw std::runtime_error("values-" + language + "/" + catalogue.file_name + " has no " + pool.name + "." + key);
+                }
+                texts.push_back(messages[pool.name][key].get<std::string>());
+            }
+        }
+        catalogue.texts.push_back(std::move(texts));
+    }
+}
+
+// текст записывается как есть (исходники в UTF-8), экранируются кавычки, обратная косая черта и управляющие символы
+static std::string make_literal(const std::string& text)
+{
+    std::string literal = "\"";
+    for (char symbol : text) {
+        switch (symbol) {
+            case '"':
+                literal += "\\\"";
+                break;
+            case '\\':
+                literal += "\\\\";
+                break;
+            case '\n':
+                literal += "\\n";
+                break;
+            case '\t':
+                literal += "\\t";
+                break;
+            default:
+                literal += symbol;
+                break;
+        }
+    }
+    literal += "\"";
+    return literal;
+}
+
+static void write_catalogue(std::ostream& output, const Catalogue& catalogue, const std::vector<std::string>& languages)
+{
+    const std::string& prefix = catalogue.prefix;
+    size_t messages_count = 0;
+
+    for (const auto& pool : catalogue.pools) {
+        output << "    inline constexpr std::string_view " << prefix << pool.name << "_messages[] = {\n";
+        for (const auto& key : pool.keys) {
+            output << "        \"" << key << "\",\n";
+        }
+        output << "    };\n\n";
+        messages_count += pool.keys.size();
+    }
+
+    output << "    inline constexpr std::string_view " << prefix << "pools[] = {\n";
+    for (const auto& pool : catalogue.pools) {
+        output << "        \"" << pool.name << "\",\n";
+    }
+    output << "    };\n\n";
+
+    output << "    inline constexpr std::span<const std::string_view> " << prefix << "messages[] = {\n";
+    for (const auto& pool : catalogue.pools) {
+        output << "        " << prefix << pool.name << "_messages,\n";
+    }
+    output << "    };\n\n";
+
+    // номер первого сообщения пула в плоских таблицах текстов
+    output << "    inline constexpr short " << prefix << "pool_offsets[] = {\n";
+    size_t offset = 0;
+    for (const auto& pool : catalogue.pools) {
+        output << "        " << offset << ",\n";
+        offset += pool.keys.size();
+    }
+    output << "    };\n\n";
+    output << "    inline constexpr size_t " << prefix << "messages_count = " << messages_count << ";\n\n";
+
+    std::string enum_name = prefix.empty() ? "MessageId" : "TuiMessageId";
+    output << "    enum class " << enum_name << " : short {\n";
+    for (const auto& pool : catalogue.pools) {
+        for (const auto& key : pool.keys) {
+            output << "        " << pool.name << "_" << key << ",\n";
+        }
+    }
+    output << "    };\n\n";
+
+    for (int wide = 0; wide < 2; wide++) {
+        output << "    // [язык][" << enum_name << "]\n";
+        output << "    inline constexpr std::" << (wide ? "wstring_view " : "string_view ") << prefix << (wide ? "wtexts" : "texts")
+               << "[][" << prefix << "messages_count] = {\n";
+        for (size_t language_index = 0; language_index < languages.size(); language_index++) {
+            output << "        { // " << languages[language_index] << "\n";
+            for (const auto& text : catalogue.texts[language_index]) {
+                output << "            " << (wide ? "L" : "") << make_literal(text) << ",\n";
+            }
+            output << "        },\n";
+        }
+        output << "    };\n\n";
+    }
+
+    output << "    static_assert(std::size(" << prefix << "pools) == std::size(" << prefix << "messages));\n";
+    output << "    static_assert(std::size(" << prefix << "texts) == std::size(languages));\n";
+    output << "    static_assert(std::size(" << prefix << "wtexts) == std::size(languages));\n";
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3) {
+        std::cerr << "Usage: message_tables_generator <resources directory> <output header>" << std::endl;
+        return 2;
+    }
+
+    try {
+        std::filesystem::path resources_directory = argv[1];
+        std::vector<std::string> languages = find_languages(resources_directory);
+
+        Catalogue messages { "messages.json", "", {}, {} };
+        Catalogue tui_messages { "tui_messages.json", "tui_", {}, {} };
+        read_catalogue(resources_directory, languages, messages);
+        read_catalogue(resources_directory, languages, tui_messages);
+
+        std::ostringstream output;
+        output << "#pragma once\n\n";
+        output << "// сгенерировано tools/message_tables_generator.cpp из res/values-*/messages.json и res/values-*/tui_messages.json,\n";
+        output << "// вручную не редактируется: после изменения каталогов генератор запускается заново\n\n";
+        output << "#include <span>\n#include <string_view>\n\n";
+        output << "namespace MessageTables {\n";
+        output << "    inline constexpr std::string_view languages[] = {\n";
+        for (const auto& language : languages) {
+            output << "        \"" << language << "\",\n";
+        }
+        output << "    };\n\n";
+        output << "    // сообщения проверки (messages.json); порядок задаёт коды MessageCode\n\n";
+        write_catalogue(output, messages, languages);
+        output << "\n    // сообщения TUI (tui_messages.json)\n\n";
+        write_catalogue(output, tui_messages, languages);
+        output << "};";
+
+        std::ofstream file(argv[2], std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error(std::string("Failed to open ") + argv[2]);
+        }
+        file << output.str();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
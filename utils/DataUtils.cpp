@@ -1,5 +1,7 @@
 #include "DataUtils.hpp"
 
+#include <algorithm>
+
 json DataUtils::JsonUtils::read(const std::string& path)
 {
     auto file = std::ifstream(path);
@@ -77,7 +79,7 @@ std::vector<std::string> DataUtils::FileUtils::get_folders_list_from_folder(std:
     return result;
 }
 
-std::vector<std::string> DataUtils::FileUtils::get_txt_files_list_from_folder(std::string folderPath)
+std::vector<std::string> DataUtils::FileUtils::get_txt_files_list_from_folder(std::string folderPath, bool recursive)
 {
     if (!std::filesystem::exists(folderPath)) {
         throw std::runtime_error("Директория не существует");
@@ -85,11 +87,24 @@ std::vector<std::string> DataUtils::FileUtils::get_txt_files_list_from_folder(st
 
     std::vector<std::string> result;
 
-    for (const auto& entry : std::filesystem::directory_iterator(folderPath)) {
-        if (entry.path().extension() == ".txt") {
+    auto add_entry = [&result](const std::filesystem::directory_entry& entry) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
             result.push_back(entry.path().string());
         }
+    };
+    if (recursive) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(folderPath)) {
+            add_entry(entry);
+        }
     }
+    else {
+        for (const auto& entry : std::filesystem::directory_iterator(folderPath)) {
+            add_entry(entry);
+        }
+    }
+
+    // порядок обхода каталога зависит от файловой системы
+    std::sort(result.begin(), result.end());
 
     return result;
 }
@@ -34,7 +34,8 @@ namespace DataUtils {
         void write_strings_to_file(std::ofstream& file, const std::vector<std::string>& strings);
         void write_strings_to_file(const std::string& path, const std::vector<std::string>& strings);
         std::vector<std::string> get_folders_list_from_folder(std::string folder_path);
-        std::vector<std::string> get_txt_files_list_from_folder(std::string folder_path);
+        // файлы .txt каталога (recursive — с подкаталогами), отсортированные по пути
+        std::vector<std::string> get_txt_files_list_from_folder(std::string folder_path, bool recursive = false);
         std::string get_input_file(std::string text);
         std::string get_output_file(std::string text);
     };
@@ -1,5 +1,7 @@
 #include "Debugger.hpp"
 
+using MessageTables::MessageId;
+
 const char* Debugger::token_types[] = {
     "Letter", 
     "Digit", 
@@ -51,30 +53,31 @@ void Debugger::add_message_to_vector(const Message& message, std::vector<std::se
     omp_unset_lock(&lock);
 }
 
+const std::string& Debugger::get_message_text(MessageStorage& message_storage, const Message& message)
+{
+    auto code = MessageCodes::find(message.message_pool, message.message_pool_identifier);
+    if (code.has_value()) {
+        return message_storage.get_text(*code);
+    }
+    return message_storage.get_current_pool()[message.message_pool][message.message_pool_identifier];
+}
+
 void Debugger::print_message(std::ostringstream& oss, const Message& message)
 {
-    auto current_message_pool = SharedRepository::get_instance().get_message_storage().get_current_pool();
-    auto message_description = current_message_pool["other"]["position"];
-    auto message_text = current_message_pool[message.message_pool][message.message_pool_identifier];
+    auto& message_storage = SharedRepository::get_instance().get_message_storage();
+    const auto& message_description = message_storage.get_text(MessageId::other_position);
+    const auto& message_text = get_message_text(message_storage, message);
     oss << message_description << ": " << message.token_index << "\t" << message.token_value << "\t" << message_text << std::endl;
 }
 
 void Debugger::print_message(std::ofstream& file, const Message& message)
 {
-    auto current_message_pool = SharedRepository::get_instance().get_message_storage().get_current_pool();
-    auto message_description = current_message_pool["other"]["position"];
-    auto message_text = current_message_pool[message.message_pool][message.message_pool_identifier];
+    auto& message_storage = SharedRepository::get_instance().get_message_storage();
+    const auto& message_description = message_storage.get_text(MessageId::other_position);
+    const auto& message_text = get_message_text(message_storage, message);
     file << message_description << ": " << message.token_index << "\t" << message.token_value << "\t" << message_text << std::endl;
 }
 
-void Debugger::print_message(const std::string& language_pool_name, std::string& validity, const Message& message)
-{
-    auto message_storage = SharedRepository::get_instance().get_message_storage();
-    auto message_description = message_storage[language_pool_name]["other"]["position"];
-    auto message_text = message_storage[language_pool_name][message.message_pool][message.message_pool_identifier];
-    validity += message_description + ": " + std::to_string(message.token_index) + "\t" + message.token_value + "\t" + message_text + "\n";
-}
-
 std::vector<std::string> Debugger::get_message_and_results(const std::vector<std::set<Message>>& messages, const std::vector<bool>& results)
 {
     std::vector<std::string> strings;
@@ -89,20 +92,40 @@ std::vector<std::string> Debugger::get_message_and_results(const std::vector<std
     return buf;
 }
 
+std::vector<std::string> Debugger::get_message_and_result(int string_index, const std::set<Message>& messages, bool result)
+{
+    auto& message_storage = SharedRepository::get_instance().get_message_storage();
+    const auto& message_description = message_storage.get_text(MessageId::other_position);
+
+    std::vector<std::string> lines;
+    lines.reserve(messages.size() + 2);
+    lines.push_back(message_storage.get_text(MessageId::other_string) + ": " + std::to_string(string_index + 1));
+    for (const auto& message : messages) {
+        lines.push_back("\t" + message_description + ": " + std::to_string(message.token_index) + "\t" + message.token_value + "\t" + get_message_text(message_storage, message));
+    }
+    if (result) {
+        lines.push_back("\t" + message_storage.get_text(MessageId::other_result) + ": " + message_storage.get_text(MessageId::other_success));
+    }
+    else {
+        lines.push_back("\t" + message_storage.get_text(MessageId::other_result) + ": " + message_storage.get_text(MessageId::other_failure));
+    }
+    return lines;
+}
+
 void Debugger::print_message_and_results(std::ostringstream& oss, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results)
 {
-    auto current_message_pool = SharedRepository::get_instance().get_message_storage().get_current_pool();
+    auto& message_storage = SharedRepository::get_instance().get_message_storage();
     for (int i = 0; i < (int)messages.size(); i++) {
-        oss << current_message_pool["other"]["string"] << ": " << i+1 << std::endl;
+        oss << message_storage.get_text(MessageId::other_string) << ": " << i+1 << std::endl;
         for (auto it = messages[i].begin(); it != messages[i].end(); it++) {
             oss << "\t";
             print_message(oss, *it);
         }
         if (results[i]) {
-            oss << "\t" << current_message_pool["other"]["result"] << ": " << current_message_pool["other"]["success"] << std::endl;
+            oss << "\t" << message_storage.get_text(MessageId::other_result) << ": " << message_storage.get_text(MessageId::other_success) << std::endl;
         }
         else {
-            oss << "\t" << current_message_pool["other"]["result"] << ": " << current_message_pool["other"]["failure"] << std::endl;
+            oss << "\t" << message_storage.get_text(MessageId::other_result) << ": " << message_storage.get_text(MessageId::other_failure) << std::endl;
         }
         if (i != int(messages.size() - 1)) {
             oss << std::endl;
@@ -112,18 +135,18 @@ void Debugger::print_message_and_results(std::ostringstream& oss, const std::vec
 
 void Debugger::print_message_and_results(std::ofstream& file, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results)
 {
-    auto current_message_pool = SharedRepository::get_instance().get_message_storage().get_current_pool();
+    auto& message_storage = SharedRepository::get_instance().get_message_storage();
     for (int i = 0; i < (int)messages.size(); i++) {
-        file << current_message_pool["other"]["string"] << ": " << i+1 << std::endl;
+        file << message_storage.get_text(MessageId::other_string) << ": " << i+1 << std::endl;
         for (auto it = messages[i].begin(); it != messages[i].end(); it++) {
             file << "\t";
             print_message(file, *it);
         }
         if (results[i]) {
-            file << "\t" << current_message_pool["other"]["result"] << ": " << current_message_pool["other"]["success"] << std::endl;
+            file << "\t" << message_storage.get_text(MessageId::other_result) << ": " << message_storage.get_text(MessageId::other_success) << std::endl;
         }
         else {
-            file << "\t" << current_message_pool["other"]["result"] << ": " << current_message_pool["other"]["failure"] << std::endl;
+            file << "\t" << message_storage.get_text(MessageId::other_result) << ": " << message_storage.get_text(MessageId::other_failure) << std::endl;
         }
         if (i != int(messages.size() - 1)) {
             file << std::endl;
@@ -131,34 +154,29 @@ void Debugger::print_message_and_results(std::ofstream& file, const std::vector<
     }
 }
 
-void Debugger::print_message_and_results(const std::vector<std::string>& message_pools_names, AlgorithmRepresentation& algorithm_representation, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results)
+void Debugger::print_message_and_results(AlgorithmRepresentation& algorithm_representation, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results)
 {
-    auto message_storage = SharedRepository::get_instance().get_message_storage();
-
-    if (messages.empty()) {
-        return;
+    // в validity сохраняются только коды сообщений (MessageCodes), текст по ним формирует читатель на своём языке
+    for (int i = 0; i < (int)messages.size(); i++) {
+        algorithm_representation.representation_strings[i].validity = make_validity(messages[i], results[i]);
     }
+}
 
-    std::vector<json> validity_vector(messages.size());
-    for (auto& message_pool_name : message_pools_names) {
-        for (int i = 0; i < (int)messages.size(); i++) {
-            std::string validity_temp_str;
-            for (auto it = messages[i].begin(); it != messages[i].end(); it++) {
-                print_message(message_pool_name, validity_temp_str, *it);
-            }
-            if (results[i]) {
-                validity_temp_str += message_storage[message_pool_name]["other"]["result"] + ": " + message_storage[message_pool_name]["other"]["success"] + "\n";
-            }
-            else {
-                validity_temp_str += message_storage[message_pool_name]["other"]["result"] + ": " + message_storage[message_pool_name]["other"]["failure"] + "\n";
-            }
-            validity_vector[i][message_pool_name] = validity_temp_str;
+json Debugger::make_validity(const std::set<Message>& messages, bool result)
+{
+    json errors = json::array();
+    for (auto it = messages.begin(); it != messages.end(); it++) {
+        auto code = MessageCodes::find(it->message_pool, it->message_pool_identifier);
+        if (!code.has_value()) {
+            continue;
         }
+        json error = json::array({ code->pool, code->message, it->token_index });
+        if (!it->token_value.empty()) {
+            error.push_back(it->token_value);
+        }
+        errors.push_back(std::move(error));
     }
-
-    for (int i = 0; i < (int)messages.size(); i++) {
-        algorithm_representation.representation_strings[i].validity = validity_vector[i];
-    }
+    return json { {"ok", result}, {"errors", std::move(errors)} };
 }
 
 void Debugger::print_tokens(std::ofstream& file, const std::string& target_string, const std::vector<VariableToken>& combined_tokens)
@@ -7,6 +7,7 @@
 #include <map>
 #include "../tokens/Tokens.hpp"
 #include "../messages/Messages.hpp"
+#include "../messages/MessageCodes.hpp"
 #include "../dto/AlgorithmRepresentation.hpp"
 #include "../repositories/SharedRepository.hpp"
 
@@ -59,11 +60,13 @@ public:
     void add_message_to_vector(const Message& message, std::vector<std::set<Message>>& messages);
     void print_message(std::ostringstream& oss, const Message& message);
     void print_message(std::ofstream& file, const Message& message);
-    void print_message(const std::string& language_pool_name, std::string& validity, const Message& message);
     std::vector<std::string> get_message_and_results(const std::vector<std::set<Message>>& messages, const std::vector<bool>& results);
+    // строки отчёта для одной проверенной строки (как в print_message_and_results, без пустой строки-разделителя)
+    std::vector<std::string> get_message_and_result(int string_index, const std::set<Message>& messages, bool result);
     void print_message_and_results(std::ostringstream& oss, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results);
     void print_message_and_results(std::ofstream& file, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results);
-    void print_message_and_results(const std::vector<std::string>& message_pools_names, AlgorithmRepresentation& algorithm_representation, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results);
+    void print_message_and_results(AlgorithmRepresentation& algorithm_representation, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results);
+    static json make_validity(const std::set<Message>& messages, bool result);
     void print_tokens(std::ofstream& file, const std::string& target_string, const std::vector<VariableToken>& combined_tokens);
 
 private:
@@ -71,4 +74,7 @@ private:
     static const char* token_types[];
     static const char* complex_token_types[];
     static const char* special_identifier_types[];
+
+    // текст сообщения текущего языка: по коду из MessageCodes, по именам пула и сообщения — только для сообщений вне каталогов
+    static const std::string& get_message_text(MessageStorage& message_storage, const Message& message);
 };
\ No newline at end of file
@@ -1,114 +1,154 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <utility>
+#include <optional>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include "Settings.hpp"
 #include "./../repositories/SharedRepository.hpp"
 
+#ifdef _WIN32
+using SharedMemoryName = std::wstring;
+#else
+using SharedMemoryName = std::string;
+#endif
+
+// именованная разделяемая память со списком строк
+// формат: Header, таблица из count + 1 смещений (строка i занимает [offsets[i], offsets[i + 1]) без нуль-терминатора),
+// затем строки с нуль-терминаторами; строка по индексу читается за O(1) без копирования.
+// в POSIX (shm_open/mmap) сегмент увеличивается на месте при записи большего набора строк,
+// открывшие его процессы переотображают память, увидев новый capacity в заголовке.
+// писатель один, generation — счётчик seqlock: читатель запоминает чётный generation, читает данные
+// и повторяет чтение, если generation за это время изменился
 class SharedMemoryFile {
 public:
+    static inline constexpr char magic[4] = { 'Q', 'D', 'S', 'M' };
+    static inline constexpr uint32_t version = 1;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t capacity;          // размер сегмента в байтах
+        uint64_t generation;        // нечётный во время записи
+        uint64_t count;
+        uint64_t strings_offset;
+        uint64_t strings_size;
+        uint64_t reserved[2];
+    };
+
+    static_assert(sizeof(Header) == 64);
+
     SharedMemoryFile(const SharedMemoryFile& other) = delete;
     SharedMemoryFile& operator=(const SharedMemoryFile& other) = delete;
-    
+
     SharedMemoryFile(SharedMemoryFile&& other) noexcept
-        : name(other.name), 
-          handle(std::move(other.handle)), 
-          view(std::move(other.view)), 
-          size(other.size) {}
-    
-    SharedMemoryFile& operator=(SharedMemoryFile&& other) noexcept {
-        name = other.name;
-        handle = std::move(other.handle);
-        view = std::move(other.view);
-        size = other.size;
+        : name(std::move(other.name)),
+          owner(std::exchange(other.owner, false)),
+          size(std::exchange(other.size, 0)),
+          handle(std::exchange(other.handle, invalid_handle)),
+          view(std::exchange(other.view, nullptr)) {}
 
-        other.view.reset();
+    SharedMemoryFile& operator=(SharedMemoryFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            name = std::move(other.name);
+            owner = std::exchange(other.owner, false);
+            size = std::exchange(other.size, 0);
+            handle = std::exchange(other.handle, invalid_handle);
+            view = std::exchange(other.view, nullptr);
+        }
         return *this;
     }
 
-    SharedMemoryFile(const std::wstring& name, const std::vector<std::string>& data)
-        : name(name)
+    // создаёт сегмент и записывает строки; созданный сегмент удаляется в close()
+    SharedMemoryFile(const SharedMemoryName& name, const std::vector<std::string>& data)
+        : name(name), owner(true)
     {
-        size = calculate_required_size(data);
-        handle.reset(CreateFileMappingW(
-            INVALID_HANDLE_VALUE, nullptr,
-            PAGE_READWRITE,
-            static_cast<DWORD>(size >> 32),
-            static_cast<DWORD>(size & 0xFFFFFFFF),
-            name.c_str()
-        ));
-        if(!handle) {
-            throw std::runtime_error("CreateFileMappingW failed");
-        }
+        create(calculate_required_size(data));
+        write(data);
+    }
 
-        view.reset(MapViewOfFile(
-            handle.get(), 
-            FILE_MAP_ALL_ACCESS, 
-            0, 
-            0, 
-            size
-        ));
-        if(!view) {
-            throw std::runtime_error("MapViewOfFile failed");
+    // открывает сегмент, созданный другим процессом
+    explicit SharedMemoryFile(const SharedMemoryName& name)
+        : name(name), owner(false)
+    {
+        open();
+
+        const Header* header = get_header();
+        if (std::memcmp(header->magic, magic, sizeof(magic)) != 0 || header->version != version) {
+            close();
+            throw std::runtime_error("Shared memory file has unknown format");
         }
+    }
 
-        write(data);
+    ~SharedMemoryFile()
+    {
+        close();
     }
 
-    explicit SharedMemoryFile(const std::wstring& name)
-        : name(name)
+    // представление строки без копирования; действительно до следующей записи в сегмент
+    std::string_view get(size_t index) const
     {
-        handle.reset(OpenFileMappingW(
-            FILE_MAP_ALL_ACCESS,
-            false,
-            name.c_str()
-        ));
-        if (!handle) {
-            throw std::runtime_error("OpenFileMapping() failed");
+        std::optional<std::string_view> result;
+        read_consistent([this, index, &result]() {
+            result = index < get_header()->count ? std::make_optional(get_view(index)) : std::nullopt;
+        });
+        if (!result.has_value()) {
+            throw std::out_of_range("SharedMemoryFile::get() index out of range");
         }
+        return result.value();
+    }
 
-        view.reset(MapViewOfFile(
-            handle.get(), 
-            FILE_MAP_ALL_ACCESS, 
-            0, 
-            0, 
-            0
-        ));
-        if (!view) {
-            throw std::runtime_error("MapViewOfFile() failed");
-        }
+    std::string_view operator[](size_t index) const
+    {
+        return get(index);
+    }
 
-        MEMORY_BASIC_INFORMATION info;
-        if (!VirtualQuery(
-            view.get(),
-            &info,
-            sizeof(info)
-        )) {
-            throw std::runtime_error("VirtualQuery() failed");
-        }
-        size = info.RegionSize;
+    // представления строк без копирования; действительны до следующей записи в сегмент
+    // все представления строятся по одному отображению, поэтому переотображение не делает их недействительными
+    std::vector<std::string_view> views() const
+    {
+        std::vector<std::string_view> result;
+        read_consistent([this, &result]() {
+            size_t strings_count = get_header()->count;
+            result.clear();
+            result.reserve(strings_count);
+            for (size_t i = 0; i < strings_count; i++) {
+                result.push_back(get_view(i));
+            }
+        });
+        return result;
     }
 
+    // копии строк одной записи
     std::vector<std::string> read() const
     {
-        const char* ptr = static_cast<const char*>(view.get());
         std::vector<std::string> result;
-        
-        // читаем количество строк
-        uint32_t count;
-        std::memcpy(&count, ptr, sizeof(count));
-        ptr += sizeof(count);
-        
-        // читаем сами строки
-        result.reserve(count);
-        for (uint32_t i = 0; i < count; ++i) {
-            result.emplace_back(ptr);
-            ptr += result.back().size() + 1;
-        }
-        
+        read_consistent([this, &result]() {
+            size_t strings_count = get_header()->count;
+            result.clear();
+            result.reserve(strings_count);
+            for (size_t i = 0; i < strings_count; i++) {
+                result.emplace_back(get_view(i));
+            }
+        });
         return result;
     }
 
@@ -116,30 +156,47 @@ public:
     {
         size_t required_size = calculate_required_size(data);
         if (size < required_size) {
-            throw std::runtime_error("Not enough memory");
+            grow(required_size);
         }
 
-        char* ptr = static_cast<char*>(view.get());
+        Header* header = get_header();
+        std::atomic_ref<uint64_t> generation(header->generation);
+        // нечётный generation должен стать видимым раньше любых изменённых данных
+        generation.store(generation.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
 
-        // записываем количество строк
-        uint32_t count = static_cast<uint32_t>(data.size());
-        std::memcpy(ptr, &count, sizeof(count));
-        ptr += sizeof(count);
-        
-        // записываем сами строки
-        for (const auto& str : data) {
-            std::memcpy(ptr, str.c_str(), str.size() + 1);
-            ptr += str.size() + 1;
+        uint64_t* offsets = reinterpret_cast<uint64_t*>(static_cast<char*>(view) + sizeof(Header));
+        uint64_t strings_offset = sizeof(Header) + (data.size() + 1) * sizeof(uint64_t);
+        char* strings = static_cast<char*>(view) + strings_offset;
+
+        uint64_t offset = 0;
+        for (size_t i = 0; i < data.size(); i++) {
+            offsets[i] = offset;
+            std::memcpy(strings + offset, data[i].c_str(), data[i].size() + 1);
+            offset += data[i].size() + 1;
         }
+        offsets[data.size()] = offset;
+
+        std::memcpy(header->magic, magic, sizeof(magic));
+        header->version = version;
+        header->capacity = size;
+        header->count = data.size();
+        header->strings_offset = strings_offset;
+        header->strings_size = offset;
 
-        FlushViewOfFile(view.get(), 0);
+        generation.store(generation.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+#ifdef _WIN32
+        FlushViewOfFile(view, 0);
+#endif
     }
 
     size_t count() const
     {
-        uint32_t count;
-        std::memcpy(&count, view.get(), sizeof(count));
-        return count;
+        size_t result = 0;
+        read_consistent([this, &result]() {
+            result = get_header()->count;
+        });
+        return result;
     }
 
     bool empty() const
@@ -147,106 +204,319 @@ public:
         return count() == 0;
     }
 
+    uint64_t get_generation() const
+    {
+        return std::atomic_ref<uint64_t>(get_header()->generation).load(std::memory_order_acquire);
+    }
+
     void close()
     {
-        view.reset();
-        handle.reset();
+#ifdef _WIN32
+        if (view != nullptr) {
+            UnmapViewOfFile(view);
+        }
+        if (handle != invalid_handle) {
+            CloseHandle(handle);
+        }
+#else
+        if (view != nullptr) {
+            munmap(view, size);
+        }
+        if (handle != invalid_handle) {
+            ::close(handle);
+            if (owner) {
+                shm_unlink(get_posix_name().c_str());
+            }
+        }
+#endif
+        view = nullptr;
+        handle = invalid_handle;
+        size = 0;
+        owner = false;
     }
 
 private:
-    struct HandleDeleter {
-        void operator()(HANDLE handle) const noexcept {
-            if (handle) {
-                CloseHandle(handle);
-            }
+#ifdef _WIN32
+    using Handle = HANDLE;
+    static inline const Handle invalid_handle = nullptr;
+#else
+    using Handle = int;
+    static inline constexpr Handle invalid_handle = -1;
+#endif
+
+    SharedMemoryName name;
+    bool owner = false;
+    mutable size_t size = 0;
+    Handle handle = invalid_handle;
+    mutable void* view = nullptr;
+
+    Header* get_header() const
+    {
+        return static_cast<Header*>(view);
+    }
+
+    const uint64_t* get_offsets() const
+    {
+        return reinterpret_cast<const uint64_t*>(static_cast<const char*>(view) + sizeof(Header));
+    }
+
+    // строка по индексу; при чтении во время записи смещения могут быть произвольными, поэтому они проверяются
+    // по размеру отображения, а несогласованный результат отбрасывает read_consistent()
+    std::string_view get_view(size_t index) const
+    {
+        const Header* header = get_header();
+        const uint64_t* offsets = get_offsets();
+        uint64_t table_end = sizeof(Header) + (header->count + 1) * sizeof(uint64_t);
+        if (header->count >= size || table_end > size || header->strings_offset > size ||
+                offsets[index] >= offsets[index + 1] || offsets[index + 1] > size - header->strings_offset) {
+            throw torn_read();
         }
-    };
+        const char* strings = static_cast<const char*>(view) + header->strings_offset;
+        return std::string_view(strings + offsets[index], offsets[index + 1] - offsets[index] - 1);
+    }
+
+    struct torn_read {};
 
-    struct ViewDeleter {
-        void operator()(void* ptr) const noexcept {
-            if (ptr) {
-                UnmapViewOfFile(ptr);
+    // выполняет чтение между двумя одинаковыми чётными generation, иначе повторяет его
+    template <typename Read>
+    void read_consistent(Read&& read) const
+    {
+        while (true) {
+            refresh();
+            std::atomic_ref<uint64_t> generation(get_header()->generation);
+            uint64_t started_generation = generation.load(std::memory_order_acquire);
+            if (started_generation % 2 != 0) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            bool is_torn = false;
+            try {
+                read();
+            }
+            catch (const torn_read&) {
+                is_torn = true;
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (generation.load(std::memory_order_relaxed) == started_generation) {
+                if (is_torn) {
+                    throw std::runtime_error("Shared memory file is corrupted");
+                }
+                return;
             }
         }
-    };
+    }
 
     static size_t calculate_required_size(const std::vector<std::string>& data)
     {
-        size_t size = sizeof(uint32_t);     // количество строк
+        size_t size = sizeof(Header) + (data.size() + 1) * sizeof(uint64_t);
         for (const auto& str : data) {
             size += str.size() + 1;         // строка + нуль-терминатор
         }
         return size;
     }
 
-    size_t size;
-    std::wstring name;
-    std::unique_ptr<std::remove_pointer_t<HANDLE>, HandleDeleter> handle {nullptr};
-    std::unique_ptr<void, ViewDeleter> view {nullptr};
+#ifdef _WIN32
+    void create(size_t required_size)
+    {
+        size = required_size;
+        handle = CreateFileMappingW(
+            INVALID_HANDLE_VALUE, nullptr,
+            PAGE_READWRITE,
+            static_cast<DWORD>(size >> 32),
+            static_cast<DWORD>(size & 0xFFFFFFFF),
+            name.c_str()
+        );
+        if (!handle) {
+            throw std::runtime_error("CreateFileMappingW failed");
+        }
+
+        view = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (!view) {
+            close();
+            throw std::runtime_error("MapViewOfFile failed");
+        }
+        std::memset(view, 0, sizeof(Header));
+    }
+
+    void open()
+    {
+        handle = OpenFileMappingW(FILE_MAP_ALL_ACCESS, false, name.c_str());
+        if (!handle) {
+            throw std::runtime_error("OpenFileMapping() failed");
+        }
+
+        view = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+        if (!view) {
+            close();
+            throw std::runtime_error("MapViewOfFile() failed");
+        }
+        size = get_header()->capacity;
+    }
+
+    // размер отображения файла подкачки фиксируется при создании
+    void grow(size_t)
+    {
+        throw std::runtime_error("Not enough memory");
+    }
+
+    void refresh() const {}
+#else
+    // имя объекта POSIX начинается с '/'
+    std::string get_posix_name() const
+    {
+        return name.starts_with('/') ? name : "/" + name;
+    }
+
+    void map(size_t new_size) const
+    {
+        if (view != nullptr) {
+            munmap(view, size);
+            view = nullptr;
+        }
+
+        void* address = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, handle, 0);
+        if (address == MAP_FAILED) {
+            throw std::runtime_error("mmap() failed");
+        }
+        view = address;
+        size = new_size;
+    }
+
+    // существующий сегмент не усекается: открывшие его процессы получили бы SIGBUS при обращении к отображению
+    void create(size_t required_size)
+    {
+        handle = shm_open(get_posix_name().c_str(), O_CREAT | O_RDWR, 0600);
+        if (handle == invalid_handle) {
+            throw std::runtime_error("shm_open() failed");
+        }
+
+        struct stat status;
+        if (fstat(handle, &status) != 0) {
+            close();
+            throw std::runtime_error("fstat() failed");
+        }
+        size_t current_size = static_cast<size_t>(status.st_size);
+        if (current_size < required_size && ftruncate(handle, static_cast<off_t>(required_size)) != 0) {
+            close();
+            throw std::runtime_error("ftruncate() failed");
+        }
+        map(std::max(current_size, required_size));
+        if (current_size < sizeof(Header)) {
+            std::memset(view, 0, sizeof(Header));
+        }
+        // нечётный generation остаётся от писателя, завершившегося во время записи
+        std::atomic_ref<uint64_t> generation(get_header()->generation);
+        if (generation.load(std::memory_order_relaxed) % 2 != 0) {
+            generation.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    void open()
+    {
+        handle = shm_open(get_posix_name().c_str(), O_RDWR, 0600);
+        if (handle == invalid_handle) {
+            throw std::runtime_error("shm_open() failed");
+        }
+
+        struct stat status;
+        if (fstat(handle, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(Header)) {
+            close();
+            throw std::runtime_error("Shared memory file is too small");
+        }
+        map(static_cast<size_t>(status.st_size));
+    }
+
+    // увеличивает сегмент на месте: имя и дескриптор сохраняются, другие процессы переотобразят его в refresh()
+    void grow(size_t required_size)
+    {
+        size_t new_size = std::max(required_size, size * 2);
+        if (ftruncate(handle, static_cast<off_t>(new_size)) != 0) {
+            throw std::runtime_error("ftruncate() failed");
+        }
+        map(new_size);
+    }
+
+    void refresh() const
+    {
+        uint64_t capacity = get_header()->capacity;
+        if (capacity > size) {
+            map(capacity);
+        }
+    }
+#endif
 };
 
 class Loader {
 public:
-    static void load(Settings settings, std::wstring shared_memory_file_name)
+    static void load(Settings settings, const SharedMemoryName& shared_memory_file_name)
     {
         switch (settings.global_settings.work_mode) {
             case MainWorkMode::File: {
                 std::vector<std::string> strings = DataUtils::FileUtils::read_strings_from_file(settings.file_settings.input_file_path);
-                shared_memory_file = std::make_unique<SharedMemoryFile>(shared_memory_file_name, strings);
+                store(shared_memory_file_name, strings);
                 break;
             }
 
             case MainWorkMode::DB: {
-                SharedRepository::get_instance().connect(settings.db_settings.db_connection);
-                auto algorithm_representations = SharedRepository::get_instance()
-                    .get_algorithm_representation_repository()
-                    .get_by_field("name", settings.db_settings.algorithm_name);
-                
-                if (algorithm_representations.size() == 0) {
-                    throw std::runtime_error("Algorithm not found by name");
+                if (!settings.db_settings.snapshot_cache_directory.empty()) {
+                    SharedRepository::get_instance().enable_snapshot_cache(settings.db_settings.snapshot_cache_directory);
                 }
-                // std::cout << "Found " << algorithm_representations.size() << " algorithm representations" << std::endl;
-
-                // фильтруем по описанию, размерности и итерациям
-                std::vector<AlgorithmRepresentation> filtered_algorithm_representations;
-                for (AlgorithmRepresentation algorithm_representation : algorithm_representations) {
-                    std::string current_lang = settings.global_settings.language == Language::Type::English ? "en" : "ru";
-                    if (!algorithm_representation.algorithm.description[current_lang].empty() &&
-                            algorithm_representation.algorithm.description[current_lang] != "-" &&
-                            algorithm_representation.algorithm.description[current_lang] != settings.db_settings.algorithm_description) {
-                        continue;
-                    }
-                    if (algorithm_representation.representation.dimensionality != settings.db_settings.dimensionality) {
-                        continue;
-                    }
-                    if (algorithm_representation.representation.iterations != settings.db_settings.iterations) {
-                        continue;
-                    }
-                    filtered_algorithm_representations.push_back(algorithm_representation);
-                }
-                // std::cout << "Filtered. " << filtered_algorithm_representations.size() << " algorithm representations remains" << std::endl;
+                SharedRepository::get_instance().open(settings.db_settings.storage, settings.db_settings.db_connection, settings.db_settings.storage_directory);
+                auto filtered_algorithm_representations = SharedRepository::get_instance()
+                    .get_algorithm_representation_repository()
+                    .get_by_filter(settings.make_representation_filter());
 
                 if (filtered_algorithm_representations.size() == 0) {
                     throw std::runtime_error("Algorithm not found");
                 }
                 auto filtered_algorithm_representation = filtered_algorithm_representations[0];
 
-                shared_memory_file = std::make_unique<SharedMemoryFile>(shared_memory_file_name, filtered_algorithm_representation.representation_strings);
+                std::vector<std::string> strings;
+                strings.reserve(filtered_algorithm_representation.representation_strings.size());
+                for (const auto& representation_string : filtered_algorithm_representation.representation_strings) {
+                    strings.push_back(representation_string.content);
+                }
+                store(shared_memory_file_name, strings);
                 break;
             }
         }
     }
 
-    static std::vector<std::string> read(std::wstring shared_memory_file_name) {
+    static std::vector<std::string> read(const SharedMemoryName& shared_memory_file_name)
+    {
+        return open(shared_memory_file_name).read();
+    }
+
+    // чтение без копирования строк; представления действительны до следующего load()
+    static std::vector<std::string_view> view(const SharedMemoryName& shared_memory_file_name)
+    {
+        return open(shared_memory_file_name).views();
+    }
+
+private:
+    static inline std::unique_ptr<SharedMemoryFile> shared_memory_file;
+
+    // повторная загрузка переписывает уже созданный сегмент, при необходимости увеличивая его
+    static void store(const SharedMemoryName& shared_memory_file_name, const std::vector<std::string>& strings)
+    {
+        if (shared_memory_file) {
+            shared_memory_file->write(strings);
+        }
+        else {
+            shared_memory_file = std::make_unique<SharedMemoryFile>(shared_memory_file_name, strings);
+        }
+    }
+
+    static const SharedMemoryFile& open(const SharedMemoryName& shared_memory_file_name)
+    {
         if (!shared_memory_file) {
             shared_memory_file = std::make_unique<SharedMemoryFile>(shared_memory_file_name);
         }
         if (shared_memory_file->empty()) {
             throw std::runtime_error("Shared memory file is empty");
         }
-        return shared_memory_file->read();
+        return *shared_memory_file;
     }
-
-private:
-    static inline std::unique_ptr<SharedMemoryFile> shared_memory_file;
 };
\ No newline at end of file
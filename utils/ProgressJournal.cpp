@@ -0,0 +1,122 @@
+#include "ProgressJournal.hpp"
+
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+#include <nlohmann/json.hpp>
+
+ProgressJournal::ProgressJournal(const std::string& file_path, const std::string& run_key)
+    : file_path(file_path), ids_file_path(file_path + ".ids"), run_key(run_key), position(0) {}
+
+bool ProgressJournal::load()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::ifstream file(file_path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    nlohmann::json journal = nlohmann::json::parse(file, nullptr, false);
+    if (journal.is_discarded() || journal.value("Version", 0) != version) {
+        throw std::runtime_error("ProgressJournal::load() unsupported journal file");
+    }
+    if (journal.value("RunKey", "") != run_key) {
+        throw std::runtime_error("ProgressJournal::load() journal belongs to another run");
+    }
+
+    // до begin() записанными считаются все записанные представления сохранённой выборки
+    committed_ids.clear();
+    size_t stored_position = journal.value("Position", (size_t)0);
+    if (stored_position != 0) {
+        std::ifstream ids_file(ids_file_path);
+        nlohmann::json stored_ids = nlohmann::json::parse(ids_file, nullptr, false);
+        if (stored_ids.is_discarded() || !stored_ids.is_array() || stored_ids.size() < stored_position) {
+            throw std::runtime_error("ProgressJournal::load() failed to read selection file");
+        }
+        for (size_t i = 0; i < stored_position; i++) {
+            committed_ids.insert(stored_ids[i].get<int>());
+        }
+    }
+    for (int representation_id : journal.value("Committed", std::vector<int>())) {
+        committed_ids.insert(representation_id);
+    }
+    return true;
+}
+
+void ProgressJournal::begin(std::vector<int> representation_ids)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::sort(representation_ids.begin(), representation_ids.end());
+    this->representation_ids = std::move(representation_ids);
+    position = 0;
+    std::erase_if(committed_ids, [this](int representation_id) {
+        return !std::binary_search(this->representation_ids.begin(), this->representation_ids.end(), representation_id);
+    });
+
+    // журнал с нулевой позицией не зависит от файла выборки, поэтому падение между записями файлов его не портит
+    save();
+    write_file(ids_file_path, nlohmann::json(this->representation_ids).dump());
+    advance();
+    save();
+}
+
+bool ProgressJournal::is_committed(int representation_id) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto end = representation_ids.begin() + position;
+    return std::binary_search(representation_ids.begin(), end, representation_id) || committed_ids.contains(representation_id);
+}
+
+void ProgressJournal::commit(int representation_id)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (std::binary_search(representation_ids.begin(), representation_ids.begin() + position, representation_id)) return;
+    committed_ids.insert(representation_id);
+    advance();
+    save();
+}
+
+void ProgressJournal::finish()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::error_code error;
+    std::filesystem::remove(file_path, error);
+    std::filesystem::remove(ids_file_path, error);
+}
+
+void ProgressJournal::advance()
+{
+    while (position < representation_ids.size() && committed_ids.erase(representation_ids[position]) != 0) {
+        position++;
+    }
+}
+
+void ProgressJournal::save() const
+{
+    nlohmann::json journal;
+    journal["Version"] = version;
+    journal["RunKey"] = run_key;
+    journal["Position"] = position;
+    journal["Committed"] = std::vector<int>(committed_ids.begin(), committed_ids.end());
+    write_file(file_path, journal.dump());
+}
+
+// пишем во временный файл и подменяем, чтобы при падении процесса файл остался целым
+void ProgressJournal::write_file(const std::string& file_path, const std::string& content)
+{
+    std::string temp_file_path = file_path + ".tmp";
+    {
+        std::ofstream file(temp_file_path, std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("ProgressJournal::save() failed to open file");
+        }
+        file << content;
+    }
+    std::filesystem::rename(temp_file_path, file_path);
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <set>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// журнал пакетной проверки для продолжения прерванного запуска (--resume)
+// выборка запуска (отсортированные representation_id) записывается один раз в начале запуска в файл <журнал>.ids,
+// а сам журнал хранит позицию в выборке — сколько первых представлений выборки записаны в БД, —
+// и записанные представления после неё (их немного: не больше числа одновременно проверяемых).
+// при продолжении записанными считаются только представления сохранённой выборки, поэтому представления,
+// добавленные после прерванного запуска (в том числе с меньшими идентификаторами), проверяются.
+// validity строк представления записывается в одной транзакции, поэтому частично записанных представлений не бывает.
+// файл журнала перезаписывается целиком (через временный файл) после каждого записанного представления
+class ProgressJournal {
+public:
+    // run_key описывает выборку представлений и режим проверки; журнал другого запуска не продолжается
+    ProgressJournal(const std::string& file_path, const std::string& run_key);
+    ProgressJournal(const ProgressJournal&) = delete;
+    ProgressJournal& operator=(const ProgressJournal&) = delete;
+
+    // читает сохранённый журнал, false — журнала нет
+    bool load();
+    // выборка запуска; записанные представления сохранённой выборки, входящие в неё, считаются записанными
+    void begin(std::vector<int> representation_ids);
+    bool is_committed(int representation_id) const;
+    // потокобезопасно: вызывается из потоков проверки и потока отложенной записи
+    void commit(int representation_id);
+    // удаляет файлы журнала после успешного завершения запуска
+    void finish();
+
+private:
+    static constexpr int version = 2;
+
+    std::string file_path;
+    std::string ids_file_path;
+    std::string run_key;
+    std::vector<int> representation_ids;
+    size_t position;
+    std::set<int> committed_ids;
+    mutable std::mutex mutex;
+
+    void advance();
+    void save() const;
+    static void write_file(const std::string& file_path, const std::string& content);
+};
\ No newline at end of file
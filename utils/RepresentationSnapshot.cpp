@@ -0,0 +1,167 @@
+#include "RepresentationSnapshot.hpp"
+
+#include <bit>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <string_view>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+void RepresentationSnapshot::write(const std::string& file_path, const AlgorithmRepresentation& algorithm_representation, const std::string& source_version)
+{
+    static_assert(std::endian::native == std::endian::little, "RepresentationSnapshot expects little-endian platform");
+
+    const auto& representation = algorithm_representation.representation;
+    const auto& representation_strings = algorithm_representation.representation_strings;
+
+    std::string name = algorithm_representation.algorithm.name.dump();
+    std::string description = algorithm_representation.algorithm.description.dump();
+
+    std::string data = source_version + name + description;
+    std::vector<StringRecord> records;
+    records.reserve(representation_strings.size());
+    for (const auto& representation_string : representation_strings) {
+        StringRecord record {};
+        record.representation_string_id = representation_string.representation_string_id;
+        record.content_offset = data.size();
+        record.content_length = static_cast<uint32_t>(representation_string.content.size());
+        data += representation_string.content;
+
+        record.validity_offset = data.size();
+        record.validity_length = -1;
+        if (representation_string.validity.has_value()) {
+            std::string validity = representation_string.validity.value().dump();
+            record.validity_length = static_cast<int32_t>(validity.size());
+            data += validity;
+        }
+        records.push_back(record);
+    }
+
+    uint64_t dimensionality_size = representation.dimensionality.size() * sizeof(int32_t);
+    uint64_t strings_offset = sizeof(Header) + ((dimensionality_size + 7) & ~uint64_t(7));
+
+    Header header {};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.representation_id = representation.representation_id;
+    header.algorithm_id = representation.algorithm_id;
+    header.iterations = representation.iterations;
+    header.dimensionality_count = static_cast<uint32_t>(representation.dimensionality.size());
+    header.strings_count = records.size();
+    header.strings_offset = strings_offset;
+    header.data_offset = strings_offset + records.size() * sizeof(StringRecord);
+    header.source_version_length = static_cast<uint32_t>(source_version.size());
+    header.name_length = static_cast<uint32_t>(name.size());
+    header.description_length = static_cast<uint32_t>(description.size());
+
+    std::vector<int32_t> dimensionality(representation.dimensionality.begin(), representation.dimensionality.end());
+    const char padding[8] = {};
+
+    // пишем во временный файл и подменяем, чтобы другой процесс не прочитал частично записанный снимок
+    std::string temp_file_path = file_path + ".tmp";
+    {
+        std::ofstream file(temp_file_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("RepresentationSnapshot::write() failed to open file");
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(dimensionality.data()), dimensionality_size);
+        file.write(padding, strings_offset - sizeof(Header) - dimensionality_size);
+        file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(StringRecord));
+        file.write(data.data(), data.size());
+    }
+    std::filesystem::rename(temp_file_path, file_path);
+}
+
+std::optional<AlgorithmRepresentation> RepresentationSnapshot::read(const std::string& file_path, std::optional<std::string_view> source_version)
+{
+    std::error_code error;
+    uint64_t file_size = std::filesystem::file_size(file_path, error);
+    if (error || file_size < sizeof(Header)) {
+        return std::nullopt;
+    }
+
+    boost::interprocess::file_mapping file_mapping(file_path.c_str(), boost::interprocess::read_only);
+    boost::interprocess::mapped_region region(file_mapping, boost::interprocess::read_only);
+    const char* file_data = static_cast<const char*>(region.get_address());
+
+    Header header;
+    std::memcpy(&header, file_data, sizeof(header));
+    // размеры массивов сравниваются с остатком файла делением, чтобы произведение из повреждённого заголовка не переполнилось
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 ||
+            header.version != version ||
+            header.dimensionality_count > (file_size - sizeof(Header)) / sizeof(int32_t) ||
+            header.strings_offset < sizeof(Header) + header.dimensionality_count * sizeof(int32_t) ||
+            header.strings_offset > file_size ||
+            header.strings_count > (file_size - header.strings_offset) / sizeof(StringRecord) ||
+            header.data_offset != header.strings_offset + header.strings_count * sizeof(StringRecord)) {
+        return std::nullopt;
+    }
+
+    const char* data = file_data + header.data_offset;
+    uint64_t data_size = file_size - header.data_offset;
+    auto data_view = [data, data_size](uint64_t offset, uint64_t length) -> std::optional<std::string_view> {
+        if (offset > data_size || length > data_size - offset) {
+            return std::nullopt;
+        }
+        return std::string_view(data + offset, length);
+    };
+
+    auto stored_source_version = data_view(0, header.source_version_length);
+    if (!stored_source_version.has_value() || (source_version.has_value() && stored_source_version.value() != source_version.value())) {
+        return std::nullopt;
+    }
+    auto name = data_view(header.source_version_length, header.name_length);
+    auto description = data_view((uint64_t)header.source_version_length + header.name_length, header.description_length);
+    if (!name.has_value() || !description.has_value()) {
+        return std::nullopt;
+    }
+
+    std::vector<int> dimensionality(header.dimensionality_count);
+    for (uint32_t i = 0; i < header.dimensionality_count; i++) {
+        int32_t value;
+        std::memcpy(&value, file_data + sizeof(Header) + i * sizeof(int32_t), sizeof(value));
+        dimensionality[i] = value;
+    }
+
+    std::vector<RepresentationStringDTO> representation_strings;
+    representation_strings.reserve(header.strings_count);
+    const char* records = file_data + header.strings_offset;
+    for (uint64_t i = 0; i < header.strings_count; i++) {
+        StringRecord record;
+        std::memcpy(&record, records + i * sizeof(StringRecord), sizeof(record));
+
+        auto content = data_view(record.content_offset, record.content_length);
+        if (!content.has_value()) {
+            return std::nullopt;
+        }
+        std::optional<json> validity;
+        if (record.validity_length >= 0) {
+            auto validity_text = data_view(record.validity_offset, record.validity_length);
+            if (!validity_text.has_value()) {
+                return std::nullopt;
+            }
+            validity = json::parse(validity_text.value(), nullptr, false);
+            if (validity->is_discarded()) {
+                return std::nullopt;
+            }
+        }
+        representation_strings.emplace_back(record.representation_string_id, header.representation_id, std::string(content.value()), std::move(validity));
+    }
+
+    json name_json = json::parse(name.value(), nullptr, false);
+    json description_json = json::parse(description.value(), nullptr, false);
+    if (name_json.is_discarded() || description_json.is_discarded()) {
+        return std::nullopt;
+    }
+
+    AlgorithmRepresentation algorithm_representation(
+        AlgorithmDTO(header.algorithm_id, std::move(name_json), std::move(description_json)),
+        RepresentationDTO(header.representation_id, header.algorithm_id, dimensionality, header.iterations),
+        std::move(representation_strings)
+    );
+    algorithm_representation.mark_clean();
+    return algorithm_representation;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <optional>
+#include <string_view>
+#include <cstdint>
+
+#include "../dto/AlgorithmRepresentation.hpp"
+
+// снимок представления алгоритма на диске (двоичный формат, пригодный для отображения в память, little-endian):
+//   Header
+//   int32_t dimensionality[dimensionality_count] (с выравниванием до 8 байт)
+//   StringRecord[strings_count]
+//   данные: версия источника, name (JSON), description (JSON), содержимое и validity (JSON) строк
+// версия источника — строка, по которой репозиторий проверяет, что представление в БД не менялось
+namespace RepresentationSnapshot {
+    inline constexpr char magic[4] = { 'Q', 'D', 'S', 'N' };
+    inline constexpr uint32_t version = 1;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        int32_t representation_id;
+        int32_t algorithm_id;
+        int32_t iterations;
+        uint32_t dimensionality_count;
+        uint64_t strings_count;
+        uint64_t strings_offset;            // смещение массива StringRecord
+        uint64_t data_offset;               // смещение данных, относительно него заданы смещения StringRecord
+        uint32_t source_version_length;
+        uint32_t name_length;
+        uint32_t description_length;
+        uint32_t reserved;
+    };
+
+    struct StringRecord {
+        int64_t representation_string_id;
+        uint64_t content_offset;
+        uint64_t validity_offset;
+        uint32_t content_length;
+        int32_t validity_length;            // -1, если validity отсутствует
+    };
+
+    static_assert(sizeof(Header) == 64);
+    static_assert(sizeof(StringRecord) == 32);
+
+    // имя файла снимка в каталоге (SnapshotCacheRepository, InMemoryDatabase)
+    inline std::string file_name(int representation_id)
+    {
+        return "representation_" + std::to_string(representation_id) + ".qds";
+    }
+    inline constexpr std::string_view file_extension = ".qds";
+
+    void write(const std::string& file_path, const AlgorithmRepresentation& algorithm_representation, const std::string& source_version);
+    // std::nullopt, если файла нет, он повреждён или записан для другой версии источника
+    // (без source_version версия не проверяется)
+    std::optional<AlgorithmRepresentation> read(const std::string& file_path, std::optional<std::string_view> source_version = std::nullopt);
+};
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include "ResultChannel.hpp"
+
+#include <bit>
+#include <new>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <stdexcept>
+
+ResultChannel::ResultChannel(const std::string& name, size_t capacity)
+    : name(name), owner(true)
+{
+    // в половину буфера должна помещаться хотя бы запись без сообщений
+    if (!std::has_single_bit(capacity) || capacity < 2 * sizeof(RecordHeader)) {
+        throw std::invalid_argument("ResultChannel capacity must be a power of two not less than 32");
+    }
+
+    boost::interprocess::shared_memory_object::remove(name.c_str());
+    shared_memory = std::make_unique<boost::interprocess::shared_memory_object>(
+        boost::interprocess::create_only, name.c_str(), boost::interprocess::read_write);
+    shared_memory->truncate(static_cast<boost::interprocess::offset_t>(sizeof(Header) + capacity));
+    region = std::make_unique<boost::interprocess::mapped_region>(*shared_memory, boost::interprocess::read_write);
+
+    header = new (region->get_address()) Header();
+    std::memcpy(header->magic, magic, sizeof(magic));
+    header->version = version;
+    header->capacity = capacity;
+    data = static_cast<char*>(region->get_address()) + sizeof(Header);
+}
+
+ResultChannel::ResultChannel(const std::string& name)
+    : name(name), owner(false)
+{
+    shared_memory = std::make_unique<boost::interprocess::shared_memory_object>(
+        boost::interprocess::open_only, name.c_str(), boost::interprocess::read_write);
+    region = std::make_unique<boost::interprocess::mapped_region>(*shared_memory, boost::interprocess::read_write);
+
+    header = static_cast<Header*>(region->get_address());
+    if (region->get_size() < sizeof(Header) ||
+            std::memcmp(header->magic, magic, sizeof(magic)) != 0 ||
+            header->version != version ||
+            region->get_size() < sizeof(Header) + header->capacity) {
+        throw std::runtime_error("ResultChannel has unknown format");
+    }
+    data = static_cast<char*>(region->get_address()) + sizeof(Header);
+}
+
+ResultChannel::~ResultChannel()
+{
+    region.reset();
+    shared_memory.reset();
+    if (owner) {
+        boost::interprocess::shared_memory_object::remove(name.c_str());
+    }
+}
+
+void ResultChannel::begin(size_t strings_count)
+{
+    header->strings_count.store(strings_count, std::memory_order_release);
+}
+
+bool ResultChannel::try_publish(int string_index, bool result, const std::set<Message>& messages)
+{
+    // сообщения с неизвестными кодами не передаются (как и в VerificationCache)
+    std::vector<std::pair<MessageCode, const Message*>> codes;
+    codes.reserve(messages.size());
+    size_t size = sizeof(RecordHeader);
+    for (const auto& message : messages) {
+        auto code = MessageCodes::find(message.message_pool, message.message_pool_identifier);
+        if (!code.has_value()) {
+            continue;
+        }
+        codes.emplace_back(code.value(), &message);
+        size += sizeof(MessageRecord) + message.token_value.size();
+    }
+    size = (size + alignment - 1) & ~(alignment - 1);
+
+    // запись не длиннее половины буфера помещается в пустой буфер при любом положении head
+    // (пропуск до конца буфера короче самой записи); более длинная могла бы не поместиться никогда
+    uint64_t capacity = header->capacity;
+    if (size > capacity / 2 || size >= skip_marker) {
+        throw std::runtime_error("ResultChannel record is larger than half of the buffer");
+    }
+
+    uint64_t head = header->head.load(std::memory_order_relaxed);
+    uint64_t tail = header->tail.load(std::memory_order_acquire);
+    uint64_t offset = head & (capacity - 1);
+    uint64_t contiguous = capacity - offset;
+    uint64_t required = size <= contiguous ? size : contiguous + size;
+    if (capacity - (head - tail) < required) {
+        return false;
+    }
+
+    if (size > contiguous) {
+        std::memcpy(data + offset, &skip_marker, sizeof(skip_marker));
+        head += contiguous;
+        offset = 0;
+    }
+
+    char* record = data + offset;
+    RecordHeader record_header {
+        static_cast<uint32_t>(size),
+        string_index,
+        result ? 1u : 0u,
+        static_cast<uint32_t>(codes.size())
+    };
+    std::memcpy(record, &record_header, sizeof(record_header));
+
+    char* message_records = record + sizeof(RecordHeader);
+    char* values = message_records + codes.size() * sizeof(MessageRecord);
+    for (size_t i = 0; i < codes.size(); i++) {
+        const auto& [code, message] = codes[i];
+        MessageRecord message_record {
+            message->token_index,
+            code.pool,
+            code.message,
+            static_cast<uint32_t>(message->token_value.size()),
+            0
+        };
+        std::memcpy(message_records + i * sizeof(MessageRecord), &message_record, sizeof(message_record));
+        std::memcpy(values, message->token_value.data(), message->token_value.size());
+        values += message->token_value.size();
+    }
+
+    header->head.store(head + size, std::memory_order_release);
+    return true;
+}
+
+void ResultChannel::publish(int string_index, bool result, const std::set<Message>& messages)
+{
+    while (!try_publish(string_index, result, messages)) {
+        if (header->cancelled.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+void ResultChannel::finish()
+{
+    header->finished.store(1, std::memory_order_release);
+}
+
+std::optional<StringResult> ResultChannel::try_consume()
+{
+    uint64_t capacity = header->capacity;
+    uint64_t tail = header->tail.load(std::memory_order_relaxed);
+    uint64_t head = header->head.load(std::memory_order_acquire);
+    if (tail == head) {
+        return std::nullopt;
+    }
+
+    uint64_t offset = tail & (capacity - 1);
+    uint32_t size;
+    std::memcpy(&size, data + offset, sizeof(size));
+    if (size == skip_marker) {
+        tail += capacity - offset;
+        offset = 0;
+        std::memcpy(&size, data, sizeof(size));
+    }
+
+    const char* record = data + offset;
+    RecordHeader record_header;
+    std::memcpy(&record_header, record, sizeof(record_header));
+
+    StringResult string_result { record_header.string_index, record_header.result != 0, {} };
+    const char* message_records = record + sizeof(RecordHeader);
+    const char* values = message_records + record_header.messages_count * sizeof(MessageRecord);
+    for (uint32_t i = 0; i < record_header.messages_count; i++) {
+        MessageRecord message_record;
+        std::memcpy(&message_record, message_records + i * sizeof(MessageRecord), sizeof(message_record));
+        MessageCode code { message_record.pool, message_record.message };
+        std::string value(values, message_record.value_length);
+        values += message_record.value_length;
+        if (!MessageCodes::is_valid(code)) {
+            continue;
+        }
+        string_result.messages.insert(Message(
+            record_header.string_index,
+            message_record.token_index,
+            value,
+            MessageCodes::pool_name(code),
+            MessageCodes::message_name(code)
+        ));
+    }
+
+    header->tail.store(tail + size, std::memory_order_release);
+    return string_result;
+}
+
+void ResultChannel::cancel()
+{
+    header->cancelled.store(1, std::memory_order_release);
+}
+
+bool ResultChannel::is_cancelled() const
+{
+    return header->cancelled.load(std::memory_order_acquire) != 0;
+}
+
+size_t ResultChannel::get_strings_count() const
+{
+    return header->strings_count.load(std::memory_order_acquire);
+}
+
+bool ResultChannel::is_finished() const
+{
+    // finished читается до head: после finish() писатель уже не сдвигает head
+    return header->finished.load(std::memory_order_acquire) &&
+        header->tail.load(std::memory_order_relaxed) == header->head.load(std::memory_order_acquire);
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <optional>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "../messages/Messages.hpp"
+#include "../messages/MessageCodes.hpp"
+
+// результат проверки одной строки, прочитанный из ResultChannel
+struct StringResult {
+    int string_index;
+    bool result;
+    std::set<Message> messages;
+};
+
+// канал результатов проверки в разделяемой памяти: кольцевой буфер с одним писателем (верификатор)
+// и одним читателем (TUI). запись: RecordHeader, MessageRecord[messages_count], значения токенов;
+// коды сообщений языконезависимые (MessageCodes), текст формирует читатель на своём языке.
+// head меняет только писатель, tail — только читатель, поэтому блокировки не нужны.
+// записи выравниваются на 8 байт и не разрываются на конце буфера: остаток помечается пропуском,
+// поэтому запись не может быть длиннее половины буфера (try_publish бросает runtime_error)
+class ResultChannel {
+public:
+    // создаёт канал; существующий сегмент с тем же именем пересоздаётся и удаляется в деструкторе
+    ResultChannel(const std::string& name, size_t capacity);
+    // открывает канал, созданный другим процессом
+    explicit ResultChannel(const std::string& name);
+    ~ResultChannel();
+    ResultChannel(const ResultChannel&) = delete;
+    ResultChannel& operator=(const ResultChannel&) = delete;
+
+    // писатель
+    void begin(size_t strings_count);
+    bool try_publish(int string_index, bool result, const std::set<Message>& messages);
+    // ждёт, пока читатель освободит место; после cancel() результаты отбрасываются
+    void publish(int string_index, bool result, const std::set<Message>& messages);
+    void finish();
+    // читатель отменил проверку: писателю следует прекратить её, не дожидаясь оставшихся строк
+    bool is_cancelled() const;
+
+    // читатель
+    std::optional<StringResult> try_consume();
+    // читатель больше не ждёт результатов, писатель не должен блокироваться на заполненном буфере
+    void cancel();
+    size_t get_strings_count() const;
+    // писатель завершил работу и все записи прочитаны
+    bool is_finished() const;
+
+    static inline constexpr char magic[4] = { 'Q', 'D', 'R', 'C' };
+    static inline constexpr uint32_t version = 1;
+    static inline constexpr size_t default_capacity = 1 << 20;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint64_t capacity;                      // степень двойки
+        std::atomic<uint64_t> strings_count;
+        std::atomic<uint32_t> finished;
+        std::atomic<uint32_t> cancelled;
+        alignas(64) std::atomic<uint64_t> head; // позиции растут монотонно, смещение — позиция по модулю capacity
+        alignas(64) std::atomic<uint64_t> tail;
+    };
+
+    struct RecordHeader {
+        uint32_t size;                          // вместе с сообщениями и выравниванием; skip_marker — пропуск до конца буфера
+        int32_t string_index;
+        uint32_t result;
+        uint32_t messages_count;
+    };
+
+    struct MessageRecord {
+        int32_t token_index;
+        int16_t pool;
+        int16_t message;
+        uint32_t value_length;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 192);
+    static_assert(sizeof(RecordHeader) == 16);
+    static_assert(sizeof(MessageRecord) == 16);
+    static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+private:
+    std::string name;
+    bool owner;
+    std::unique_ptr<boost::interprocess::shared_memory_object> shared_memory;
+    std::unique_ptr<boost::interprocess::mapped_region> region;
+    Header* header = nullptr;
+    char* data = nullptr;
+
+    static inline constexpr uint32_t skip_marker = 0xFFFFFFFF;
+    static inline constexpr size_t alignment = 8;
+};
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "ResultSerializer.hpp"
+
+#include <bit>
+#include <cstring>
+#include <tsl/hopscotch_map.h>
+
+void ResultSerializer::JsonLines::write_string(std::ostream& stream, std::string_view value)
+{
+    static const char hex_digits[] = "0123456789abcdef";
+
+    stream.put('"');
+    for (char symbol : value) {
+        switch (symbol) {
+            case '"':
+                stream.write("\\\"", 2);
+                break;
+            case '\\':
+                stream.write("\\\\", 2);
+                break;
+            case '\n':
+                stream.write("\\n", 2);
+                break;
+            case '\r':
+                stream.write("\\r", 2);
+                break;
+            case '\t':
+                stream.write("\\t", 2);
+                break;
+            default:
+                if (static_cast<unsigned char>(symbol) < 0x20) {
+                    char escaped[6] = { '\\', 'u', '0', '0',
+                        hex_digits[(symbol >> 4) & 0x0F],
+                        hex_digits[symbol & 0x0F] };
+                    stream.write(escaped, sizeof(escaped));
+                }
+                else {
+                    stream.put(symbol);
+                }
+                break;
+        }
+    }
+    stream.put('"');
+}
+
+void ResultSerializer::JsonLines::write_record(std::ostream& stream, int index, bool result, const std::set<Message>& messages)
+{
+    stream << "{\"index\":" << index << ",\"ok\":" << (result ? "true" : "false") << ",\"errors\":[";
+    for (auto it = messages.begin(); it != messages.end(); it++) {
+        if (it != messages.begin()) {
+            stream.put(',');
+        }
+        stream << "{\"token_index\":" << it->token_index << ",\"pool\":";
+        write_string(stream, it->message_pool);
+        stream << ",\"id\":";
+        write_string(stream, it->message_pool_identifier);
+        stream << ",\"value\":";
+        write_string(stream, it->token_value);
+        stream.put('}');
+    }
+    stream << "]}\n";
+}
+
+void ResultSerializer::JsonLines::write(std::ostream& stream, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results)
+{
+    for (int i = 0; i < (int)messages.size(); i++) {
+        write_record(stream, i+1, results[i], messages[i]);
+    }
+}
+
+void ResultSerializer::Binary::write(std::ostream& stream, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results)
+{
+    static_assert(std::endian::native == std::endian::little, "ResultSerializer::Binary expects little-endian platform");
+
+    uint32_t errors_count = 0;
+    for (const auto& string_messages : messages) {
+        errors_count += static_cast<uint32_t>(string_messages.size());
+    }
+
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = version;
+    header.strings_count = static_cast<uint32_t>(messages.size());
+    header.errors_count = errors_count;
+    header.errors_offset = sizeof(Header) + sizeof(StringRecord) * header.strings_count;
+    header.string_table_offset = header.errors_offset + sizeof(ErrorRecord) * header.errors_count;
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    uint32_t first_error = 0;
+    for (int i = 0; i < (int)messages.size(); i++) {
+        StringRecord record {
+            static_cast<uint32_t>(i+1),
+            results[i] ? 1u : 0u,
+            first_error,
+            static_cast<uint32_t>(messages[i].size())
+        };
+        stream.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        first_error += record.errors_count;
+    }
+
+    // таблица строк накапливается в памяти, имена пулов и идентификаторы сообщений не дублируются
+    std::string string_table;
+    tsl::hopscotch_map<std::string, uint32_t> interned_strings;
+    auto intern = [&string_table, &interned_strings](const std::string& value) -> uint32_t {
+        auto it = interned_strings.find(value);
+        if (it != interned_strings.end()) {
+            return it->second;
+        }
+        uint32_t offset = static_cast<uint32_t>(string_table.size());
+        string_table.append(value);
+        string_table.push_back('\0');
+        interned_strings.emplace(value, offset);
+        return offset;
+    };
+    auto append = [&string_table](const std::string& value) -> uint32_t {
+        uint32_t offset = static_cast<uint32_t>(string_table.size());
+        string_table.append(value);
+        string_table.push_back('\0');
+        return offset;
+    };
+
+    const uint32_t empty_offset = intern("");
+    for (const auto& string_messages : messages) {
+        for (const auto& message : string_messages) {
+            ErrorRecord record {
+                message.token_index,
+                intern(message.message_pool),
+                intern(message.message_pool_identifier),
+                message.token_value.empty() ? empty_offset : append(message.token_value)
+            };
+            stream.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+    }
+
+    stream.write(string_table.data(), string_table.size());
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+
+#include "../messages/Messages.hpp"
+
+enum class OutputFormat : short {
+    Text,
+    JsonLines,
+    Binary
+};
+
+inline std::string output_format_to_string(OutputFormat output_format)
+{
+    switch (output_format) {
+        case OutputFormat::Text:
+            return "Text";
+        case OutputFormat::JsonLines:
+            return "jsonl";
+        case OutputFormat::Binary:
+            return "bin";
+        default:
+            throw std::invalid_argument("Unknown output format");
+    }
+}
+
+inline OutputFormat output_format_from_string(const std::string& output_format)
+{
+    if (output_format == "Text" || output_format == "text") {
+        return OutputFormat::Text;
+    }
+    else if (output_format == "jsonl" || output_format == "JsonLines") {
+        return OutputFormat::JsonLines;
+    }
+    else if (output_format == "bin" || output_format == "Binary") {
+        return OutputFormat::Binary;
+    }
+    else {
+        throw std::invalid_argument("Unknown output format");
+    }
+}
+
+// потоковая запись результатов проверки в машиночитаемом виде
+// (без построения DOM nlohmann::json)
+namespace ResultSerializer {
+    // JSON Lines: одна строка на каждую проверяемую строку
+    // {"index":1,"ok":false,"errors":[{"token_index":3,"pool":"symbol","id":"comma","value":""}]}
+    namespace JsonLines {
+        void write_string(std::ostream& stream, std::string_view value);
+        void write_record(std::ostream& stream, int index, bool result, const std::set<Message>& messages);
+        void write(std::ostream& stream, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results);
+    };
+
+    // двоичный файл фиксированной ширины (little-endian), пригодный для отображения в память:
+    //   Header
+    //   StringRecord[strings_count]
+    //   ErrorRecord[errors_count]
+    //   таблица строк (нуль-терминированные строки, на которые ссылаются ErrorRecord)
+    namespace Binary {
+        inline constexpr char magic[4] = { 'Q', 'D', 'R', 'S' };
+        inline constexpr uint32_t version = 1;
+
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint32_t strings_count;
+            uint32_t errors_count;
+            uint64_t errors_offset;
+            uint64_t string_table_offset;
+        };
+
+        struct StringRecord {
+            uint32_t index;             // номер строки (с единицы, как в текстовом отчёте)
+            uint32_t ok;
+            uint32_t first_error;       // индекс первой ошибки в массиве ErrorRecord
+            uint32_t errors_count;
+        };
+
+        struct ErrorRecord {
+            int32_t token_index;
+            uint32_t pool_offset;       // смещения в таблице строк
+            uint32_t id_offset;
+            uint32_t value_offset;
+        };
+
+        static_assert(sizeof(Header) == 32);
+        static_assert(sizeof(StringRecord) == 16);
+        static_assert(sizeof(ErrorRecord) == 16);
+
+        void write(std::ostream& stream, const std::vector<std::set<Message>>& messages, const std::vector<bool>& results);
+    };
+};
\ No newline at end of file
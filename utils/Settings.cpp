@@ -1,7 +1,30 @@
 #include "Settings.hpp"
 
 Settings::Settings()
-    : global_settings(), file_settings(), db_settings() {}
+    : global_settings(), file_settings(), db_settings()
+{
+    global_settings.tiered_verification = true;
+    global_settings.daemon = false;
+    global_settings.socket_path = "qdeterminant.sock";
+    global_settings.daemon_threads = 4;
+    global_settings.messages_override_file_path = "";
+    global_settings.coordinator = false;
+    global_settings.shard_size = 0;
+    global_settings.publish_shared_memory_name = "";
+    file_settings.output_format = OutputFormat::Text;
+    file_settings.recursive = false;
+    db_settings.storage = RepositoryStorage::PostgreSQL;
+    db_settings.iterations = 0;
+    db_settings.batch = false;
+    db_settings.pool_size = 4;
+    db_settings.concurrency = 4;
+    db_settings.write_behind_depth = 64;
+    db_settings.listen = false;
+    db_settings.listen_window = 200;
+    db_settings.idle_timeout = 0;
+    db_settings.journal_file_path = "";
+    db_settings.resume = false;
+}
 
 Settings::Settings(const std::string& config_file_path)
 {
@@ -17,6 +40,17 @@ void Settings::write_settings(const std::string& config_file_path)
     }
 }
 
+AlgorithmRepresentationFilter Settings::make_representation_filter() const
+{
+    return AlgorithmRepresentationFilter(
+        db_settings.algorithm_name,
+        db_settings.algorithm_description,
+        global_settings.language == Language::Type::English ? "en" : "ru",
+        db_settings.dimensionality,
+        db_settings.iterations
+    );
+}
+
 tsl::hopscotch_map<std::string, std::string> Settings::parse_db_params(const std::string& db_connection)
 {
     auto buf = db_connection
@@ -66,9 +100,24 @@ void Settings::read_json_file(const std::string& config_file_path)
     this->global_settings.debug_mode = debug_mode_from_string(config["Settings"]["Global"]["DebugMode"]);
     this->global_settings.errors_mode = syntax_block_working_mode_from_string(config["Settings"]["Global"]["Errors"]);
     this->global_settings.language = Language::type_from_string(config["Settings"]["Global"]["Language"]);
+    this->global_settings.cache_file_path = config["Settings"]["Global"].value("CacheFile", "");
+    this->global_settings.tiered_verification = config["Settings"]["Global"].value("TieredVerification", true);
+    this->global_settings.daemon = config["Settings"]["Global"].value("Daemon", false);
+    this->global_settings.socket_path = config["Settings"]["Global"].value("SocketPath", "qdeterminant.sock");
+    this->global_settings.daemon_threads = config["Settings"]["Global"].value("DaemonThreads", 4);
+    this->global_settings.messages_override_file_path = config["Settings"]["Global"].value("MessagesOverrideFile", "");
+    this->global_settings.coordinator = config["Settings"]["Global"].value("Coordinator", false);
+    this->global_settings.workers = config["Settings"]["Global"].value("Workers", std::vector<std::string>());
+    this->global_settings.shard_size = config["Settings"]["Global"].value("ShardSize", 0);
+    this->global_settings.publish_shared_memory_name = config["Settings"]["Global"].value("PublishSharedMemory", "");
 
     this->file_settings.input_file_path = config["Settings"]["File"]["InputFile"];
     this->file_settings.output_file_path = config["Settings"]["File"]["OutputFile"];
+    this->file_settings.output_format = output_format_from_string(config["Settings"]["File"].value("OutputFormat", "Text"));
+    this->file_settings.input_directory_path = config["Settings"]["File"].value("InputDir", "");
+    this->file_settings.output_directory_path = config["Settings"]["File"].value("OutputDir", "");
+    this->file_settings.recursive = config["Settings"]["File"].value("Recursive", false);
+    this->file_settings.input_shared_memory_name = config["Settings"]["File"].value("InputSharedMemory", "");
 
     auto db_params = parse_db_params(config["Settings"]["DB"]["DBConnection"]);
     try {
@@ -78,11 +127,23 @@ void Settings::read_json_file(const std::string& config_file_path)
         db_params["password"] = "";
     }
     this->db_settings.db_connection = db_params_to_string(db_params);
+    this->db_settings.storage = repository_storage_from_string(config["Settings"]["DB"].value("Storage", "PostgreSQL"));
+    this->db_settings.storage_directory = config["Settings"]["DB"].value("StorageDir", "");
     this->db_settings.algorithm_name = config["Settings"]["DB"]["AlgorithmName"];
     this->db_settings.algorithm_description = config["Settings"]["DB"]["AlgorithmDescription"];
     this->db_settings.dimensionality = config["Settings"]["DB"]["Dimensionality"].get<std::vector<int>>();
     this->db_settings.iterations = config["Settings"]["DB"]["Iterations"];
     this->db_settings.representation_file_path = config["Settings"]["DB"]["RepresentationFile"];
+    this->db_settings.batch = config["Settings"]["DB"].value("Batch", false);
+    this->db_settings.pool_size = config["Settings"]["DB"].value("PoolSize", 4);
+    this->db_settings.concurrency = config["Settings"]["DB"].value("Concurrency", 4);
+    this->db_settings.snapshot_cache_directory = config["Settings"]["DB"].value("SnapshotCacheDir", "");
+    this->db_settings.write_behind_depth = config["Settings"]["DB"].value("WriteBehindDepth", 64);
+    this->db_settings.listen = config["Settings"]["DB"].value("Listen", false);
+    this->db_settings.listen_window = config["Settings"]["DB"].value("ListenWindow", 200);
+    this->db_settings.idle_timeout = config["Settings"]["DB"].value("IdleTimeout", 0);
+    this->db_settings.journal_file_path = config["Settings"]["DB"].value("JournalFile", "");
+    this->db_settings.resume = false;
 }
 
 void Settings::write_json_file(const std::string& config_file_path)
@@ -93,9 +154,24 @@ void Settings::write_json_file(const std::string& config_file_path)
     config["Settings"]["Global"]["DebugMode"] = debug_mode_to_string(this->global_settings.debug_mode);
     config["Settings"]["Global"]["Errors"] = syntax_block_working_mode_to_string(this->global_settings.errors_mode);
     config["Settings"]["Global"]["Language"] = Language::type_to_string(this->global_settings.language);
+    config["Settings"]["Global"]["CacheFile"] = this->global_settings.cache_file_path;
+    config["Settings"]["Global"]["TieredVerification"] = this->global_settings.tiered_verification;
+    config["Settings"]["Global"]["Daemon"] = this->global_settings.daemon;
+    config["Settings"]["Global"]["SocketPath"] = this->global_settings.socket_path;
+    config["Settings"]["Global"]["DaemonThreads"] = this->global_settings.daemon_threads;
+    config["Settings"]["Global"]["MessagesOverrideFile"] = this->global_settings.messages_override_file_path;
+    config["Settings"]["Global"]["Coordinator"] = this->global_settings.coordinator;
+    config["Settings"]["Global"]["Workers"] = this->global_settings.workers;
+    config["Settings"]["Global"]["ShardSize"] = this->global_settings.shard_size;
+    config["Settings"]["Global"]["PublishSharedMemory"] = this->global_settings.publish_shared_memory_name;
 
     config["Settings"]["File"]["InputFile"] = this->file_settings.input_file_path;
     config["Settings"]["File"]["OutputFile"] = this->file_settings.output_file_path;
+    config["Settings"]["File"]["OutputFormat"] = output_format_to_string(this->file_settings.output_format);
+    config["Settings"]["File"]["InputDir"] = this->file_settings.input_directory_path;
+    config["Settings"]["File"]["OutputDir"] = this->file_settings.output_directory_path;
+    config["Settings"]["File"]["Recursive"] = this->file_settings.recursive;
+    config["Settings"]["File"]["InputSharedMemory"] = this->file_settings.input_shared_memory_name;
 
     auto db_params = parse_db_params(this->db_settings.db_connection);
     try {
@@ -105,11 +181,22 @@ void Settings::write_json_file(const std::string& config_file_path)
         db_params["password"] = "";
     }
     config["Settings"]["DB"]["DBConnection"] = db_params_to_string(db_params);
+    config["Settings"]["DB"]["Storage"] = repository_storage_to_string(this->db_settings.storage);
+    config["Settings"]["DB"]["StorageDir"] = this->db_settings.storage_directory;
     config["Settings"]["DB"]["AlgorithmName"] = this->db_settings.algorithm_name;
     config["Settings"]["DB"]["AlgorithmDescription"] = this->db_settings.algorithm_description;
     config["Settings"]["DB"]["Dimensionality"] = this->db_settings.dimensionality;
     config["Settings"]["DB"]["Iterations"] = this->db_settings.iterations;
     config["Settings"]["DB"]["RepresentationFile"] = this->db_settings.representation_file_path;
+    config["Settings"]["DB"]["Batch"] = this->db_settings.batch;
+    config["Settings"]["DB"]["PoolSize"] = this->db_settings.pool_size;
+    config["Settings"]["DB"]["Concurrency"] = this->db_settings.concurrency;
+    config["Settings"]["DB"]["SnapshotCacheDir"] = this->db_settings.snapshot_cache_directory;
+    config["Settings"]["DB"]["WriteBehindDepth"] = this->db_settings.write_behind_depth;
+    config["Settings"]["DB"]["Listen"] = this->db_settings.listen;
+    config["Settings"]["DB"]["ListenWindow"] = this->db_settings.listen_window;
+    config["Settings"]["DB"]["IdleTimeout"] = this->db_settings.idle_timeout;
+    config["Settings"]["DB"]["JournalFile"] = this->db_settings.journal_file_path;
 
     std::ofstream configFile(config_file_path);
     configFile << config.dump(4);
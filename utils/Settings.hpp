@@ -9,6 +9,9 @@
 #include "../main-blocks/SyntaxBlock.hpp"
 #include "PasswordHasher.hpp"
 #include "Debugger.hpp"
+#include "ResultSerializer.hpp"
+#include "../dto/AlgorithmRepresentationFilter.hpp"
+#include "../repositories/RepositoryStorage.hpp"
 
 enum class MainWorkMode : short {
     File,
@@ -47,20 +50,47 @@ public:
         DebuggerWorkingMode debug_mode;
         SyntaxBlockWorkingMode errors_mode;
         Language::Type language;
+        std::string cache_file_path;
+        bool tiered_verification;
+        bool daemon;                            // принимать запросы через локальный сокет (VerificationDaemon)
+        std::string socket_path;
+        int daemon_threads;                     // одновременно обслуживаемых соединений демона
+        std::string messages_override_file_path;   // тексты переводчика поверх встроенных каталогов
+        bool coordinator;                       // раздавать шарды корпуса рабочим (VerificationCoordinator)
+        std::vector<std::string> workers;       // адреса демонов-рабочих: путь локального сокета или tcp://host:port
+        int shard_size;                         // строк или представлений в шарде, 0 — по умолчанию
+        std::string publish_shared_memory_name; // если задано, строки режима (файл или представление) публикуются через Loader для --input-shm
     };
 
     struct File {
         std::string input_file_path;
         std::string output_file_path;
+        OutputFormat output_format;
+        std::string input_directory_path;       // если задан, проверяются все .txt каталога вместо input_file_path
+        std::string output_directory_path;      // отчёты по файлам каталога, с той же структурой подкаталогов
+        bool recursive;
+        std::string input_shared_memory_name;   // если задано, строки читаются из разделяемой памяти (Loader) вместо input_file_path
     };
 
     struct DB {
+        RepositoryStorage storage;
+        std::string storage_directory;          // каталог снимков для хранилищ Memory и Snapshot
         std::string db_connection;
         std::string algorithm_name;
         std::string algorithm_description;
         std::vector<int> dimensionality;
         int iterations;
         std::string representation_file_path;
+        bool batch;             // проверять все подходящие представления, а не первое
+        int pool_size;
+        int concurrency;
+        std::string snapshot_cache_directory;   // снимки представлений на диске, пустая строка — без снимков
+        int write_behind_depth;                 // глубина очереди отложенной записи в пакетном режиме, 0 — без очереди
+        bool listen;                            // проверять строки по уведомлениям об изменении (NotificationWorker)
+        int listen_window;                      // окно накопления уведомлений, мс
+        int idle_timeout;                       // завершение после простоя, с, 0 — без ограничения
+        std::string journal_file_path;          // журнал пакетной проверки (ProgressJournal), пустая строка — без журнала
+        bool resume;                            // продолжить пакетную проверку по журналу
     };
 
     Global global_settings;
@@ -70,6 +100,7 @@ public:
     Settings();
     explicit Settings(const std::string& config_file_path);
     void write_settings(const std::string& config_file_path);
+    AlgorithmRepresentationFilter make_representation_filter() const;
     static tsl::hopscotch_map<std::string, std::string> parse_db_params(const std::string& db_connection);
     static std::string db_params_to_string(const tsl::hopscotch_map<std::string, std::string>& db_params);
 
@@ -0,0 +1,286 @@
+#include "VerificationCache.hpp"
+
+#include <bit>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <tsl/hopscotch_map.h>
+
+VerificationCache::VerificationCache(const std::string& file_path, size_t max_entries)
+    : file_path(file_path), max_entries(max_entries)
+{
+    omp_init_lock(&lock);
+    open();
+}
+
+VerificationCache::~VerificationCache()
+{
+    close();
+    omp_destroy_lock(&lock);
+}
+
+uint64_t VerificationCache::hash(std::string_view content)
+{
+    // FNV-1a
+    uint64_t result = 14695981039346656037ull;
+    for (char symbol : content) {
+        result ^= static_cast<unsigned char>(symbol);
+        result *= 1099511628211ull;
+    }
+    return result;
+}
+
+void VerificationCache::open()
+{
+    if (!std::filesystem::exists(file_path) || std::filesystem::file_size(file_path) < sizeof(Header)) {
+        return;
+    }
+
+    file_mapping = std::make_unique<boost::interprocess::file_mapping>(file_path.c_str(), boost::interprocess::read_only);
+    region = std::make_unique<boost::interprocess::mapped_region>(*file_mapping, boost::interprocess::read_only);
+
+    const char* data = static_cast<const char*>(region->get_address());
+    const Header* file_header = reinterpret_cast<const Header*>(data);
+    uint64_t expected_size = sizeof(Header) + file_header->slots_count * sizeof(Slot);
+
+    // кэш другой версии или другой грамматики не используется и будет перезаписан в save()
+    if (std::memcmp(file_header->magic, magic, sizeof(magic)) != 0 ||
+            file_header->version != version ||
+            file_header->grammar_version != syntax_block_grammar_version ||
+            !std::has_single_bit(file_header->slots_count) ||
+            region->get_size() < expected_size ||
+            region->get_size() < file_header->strings_offset + file_header->strings_size) {
+        close();
+        return;
+    }
+
+    header = file_header;
+    slots = reinterpret_cast<const Slot*>(data + sizeof(Header));
+    message_records = reinterpret_cast<const MessageRecord*>(data + header->messages_offset);
+    strings = data + header->strings_offset;
+}
+
+void VerificationCache::close()
+{
+    header = nullptr;
+    slots = nullptr;
+    message_records = nullptr;
+    strings = nullptr;
+    region.reset();
+    file_mapping.reset();
+}
+
+const VerificationCache::Slot* VerificationCache::find_slot(uint64_t content_hash, std::string_view content, SyntaxBlockWorkingMode working_mode) const
+{
+    if (header == nullptr) {
+        return nullptr;
+    }
+
+    uint64_t mask = header->slots_count - 1;
+    for (uint64_t probe = 0; probe < header->slots_count; probe++) {
+        const Slot& slot = slots[(content_hash + probe) & mask];
+        if (!slot.used) {
+            return nullptr;
+        }
+        if (slot.content_hash == content_hash &&
+                slot.content_length == content.size() &&
+                slot.working_mode == static_cast<uint8_t>(working_mode) &&
+                std::memcmp(strings + slot.content_offset, content.data(), content.size()) == 0) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+bool VerificationCache::find(uint64_t content_hash, std::string_view content, SyntaxBlockWorkingMode working_mode, int string_index, std::set<Message>& messages, bool& result) const
+{
+    const Slot* slot = find_slot(content_hash, content, working_mode);
+    if (slot == nullptr) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < slot->messages_count; i++) {
+        const MessageRecord& record = message_records[slot->first_message + i];
+        MessageCode code { record.pool, record.message };
+        if (!MessageCodes::is_valid(code)) {
+            continue;
+        }
+        messages.insert(Message(
+            string_index,
+            record.token_index,
+            std::string(strings + record.value_offset, record.value_length),
+            MessageCodes::pool_name(code),
+            MessageCodes::message_name(code)
+        ));
+    }
+    result = slot->result != 0;
+
+    #pragma omp atomic
+    hits_count++;
+
+    return true;
+}
+
+void VerificationCache::insert(uint64_t content_hash, std::string_view content, SyntaxBlockWorkingMode working_mode, bool result, const std::set<Message>& messages)
+{
+    Entry entry { content_hash, static_cast<uint32_t>(content.size()), working_mode, result, std::string(content), {}, {} };
+    entry.messages.reserve(messages.size());
+    for (const auto& message : messages) {
+        auto code = MessageCodes::find(message.message_pool, message.message_pool_identifier);
+        if (!code.has_value()) {
+            continue;
+        }
+        entry.messages.push_back(MessageRecord {
+            message.token_index,
+            code->pool,
+            code->message,
+            static_cast<uint32_t>(entry.values.size()),
+            static_cast<uint32_t>(message.token_value.size())
+        });
+        entry.values += message.token_value;
+    }
+
+    omp_set_lock(&lock);
+    pending_entries.push_back(std::move(entry));
+    omp_unset_lock(&lock);
+}
+
+std::vector<VerificationCache::Entry> VerificationCache::read_entries() const
+{
+    std::vector<Entry> entries;
+    if (header == nullptr) {
+        return entries;
+    }
+
+    // содержимое записей лежит в области строк в порядке добавления, по нему восстанавливается возраст записей
+    std::vector<const Slot*> used_slots;
+    used_slots.reserve(header->entries_count);
+    for (uint64_t i = 0; i < header->slots_count; i++) {
+        if (slots[i].used) {
+            used_slots.push_back(&slots[i]);
+        }
+    }
+    std::sort(used_slots.begin(), used_slots.end(), [](const Slot* left, const Slot* right) {
+        return left->content_offset < right->content_offset;
+    });
+
+    entries.reserve(used_slots.size());
+    for (const Slot* used_slot : used_slots) {
+        const Slot& slot = *used_slot;
+        Entry entry {
+            slot.content_hash, slot.content_length, static_cast<SyntaxBlockWorkingMode>(slot.working_mode), slot.result != 0,
+            std::string(strings + slot.content_offset, slot.content_length), {}, {}
+        };
+        for (uint32_t j = 0; j < slot.messages_count; j++) {
+            MessageRecord record = message_records[slot.first_message + j];
+            std::string_view value(strings + record.value_offset, record.value_length);
+            record.value_offset = static_cast<uint32_t>(entry.values.size());
+            entry.values += value;
+            entry.messages.push_back(record);
+        }
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+void VerificationCache::save()
+{
+    if (pending_entries.empty()) {
+        return;
+    }
+
+    std::vector<Entry> entries = read_entries();
+    for (auto& entry : pending_entries) {
+        entries.push_back(std::move(entry));
+    }
+    pending_entries.clear();
+    close();
+
+    if (entries.size() > max_entries) {
+        entries.erase(entries.begin(), entries.end() - max_entries);
+    }
+
+    // заполненность таблицы не более 50%
+    uint64_t slots_count = std::bit_ceil(std::max<uint64_t>(entries.size() * 2, 16));
+    std::vector<Slot> new_slots(slots_count, Slot {});
+    std::vector<MessageRecord> new_messages;
+    std::string new_strings;
+    uint64_t entries_count = 0;
+
+    for (const auto& entry : entries) {
+        uint64_t mask = slots_count - 1;
+        uint64_t position = entry.content_hash & mask;
+        bool is_duplicate = false;
+        while (new_slots[position].used) {
+            const Slot& slot = new_slots[position];
+            if (slot.content_hash == entry.content_hash &&
+                    slot.content_length == entry.content_length &&
+                    slot.working_mode == static_cast<uint8_t>(entry.working_mode) &&
+                    new_strings.compare(slot.content_offset, slot.content_length, entry.content) == 0) {
+                is_duplicate = true;
+                break;
+            }
+            position = (position + 1) & mask;
+        }
+        if (is_duplicate) {
+            continue;
+        }
+
+        Slot& slot = new_slots[position];
+        slot.content_hash = entry.content_hash;
+        slot.content_length = entry.content_length;
+        slot.working_mode = static_cast<uint8_t>(entry.working_mode);
+        slot.result = entry.result ? 1 : 0;
+        slot.used = 1;
+        slot.first_message = static_cast<uint32_t>(new_messages.size());
+        slot.messages_count = static_cast<uint32_t>(entry.messages.size());
+        slot.content_offset = static_cast<uint32_t>(new_strings.size());
+        new_strings += entry.content;
+
+        uint32_t values_offset = static_cast<uint32_t>(new_strings.size());
+        for (MessageRecord record : entry.messages) {
+            record.value_offset += values_offset;
+            new_messages.push_back(record);
+        }
+        new_strings += entry.values;
+        entries_count++;
+    }
+
+    Header new_header {};
+    std::memcpy(new_header.magic, magic, sizeof(magic));
+    new_header.version = version;
+    new_header.grammar_version = syntax_block_grammar_version;
+    new_header.slots_count = slots_count;
+    new_header.entries_count = entries_count;
+    new_header.messages_offset = sizeof(Header) + slots_count * sizeof(Slot);
+    new_header.messages_count = new_messages.size();
+    new_header.strings_offset = new_header.messages_offset + new_messages.size() * sizeof(MessageRecord);
+    new_header.strings_size = new_strings.size();
+
+    // пишем во временный файл и подменяем, чтобы параллельные читатели не увидели частично записанный кэш
+    std::string temp_file_path = file_path + ".tmp";
+    {
+        std::ofstream file(temp_file_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("VerificationCache::save() failed to open file");
+        }
+        file.write(reinterpret_cast<const char*>(&new_header), sizeof(new_header));
+        file.write(reinterpret_cast<const char*>(new_slots.data()), new_slots.size() * sizeof(Slot));
+        file.write(reinterpret_cast<const char*>(new_messages.data()), new_messages.size() * sizeof(MessageRecord));
+        file.write(new_strings.data(), new_strings.size());
+    }
+    std::filesystem::rename(temp_file_path, file_path);
+
+    open();
+}
+
+size_t VerificationCache::size() const
+{
+    return header == nullptr ? 0 : header->entries_count;
+}
+
+size_t VerificationCache::get_hits_count() const
+{
+    return hits_count;
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <omp.h>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "../messages/Messages.hpp"
+#include "../messages/MessageCodes.hpp"
+#include "../main-blocks/SyntaxBlock.hpp"
+
+// кэш результатов проверки строк между запусками
+// ключ: (хэш содержимого, длина, SyntaxBlockWorkingMode), версия грамматики хранится в заголовке файла;
+// содержимое строки хранится в файле и сравнивается при поиске, поэтому коллизия хэша даёт промах, а не чужой результат.
+// файл отображается в память только для чтения, поэтому поиск из потоков OpenMP идёт без блокировок;
+// новые результаты накапливаются отдельно и записываются в файл в save().
+// в файле не более max_entries записей: при переполнении вытесняются самые старые (в порядке добавления)
+class VerificationCache {
+public:
+    static inline constexpr size_t default_max_entries = 1u << 20;
+
+    explicit VerificationCache(const std::string& file_path, size_t max_entries = default_max_entries);
+    ~VerificationCache();
+    VerificationCache(const VerificationCache&) = delete;
+    VerificationCache& operator=(const VerificationCache&) = delete;
+
+    static uint64_t hash(std::string_view content);
+
+    bool find(uint64_t content_hash, std::string_view content, SyntaxBlockWorkingMode working_mode, int string_index, std::set<Message>& messages, bool& result) const;
+    void insert(uint64_t content_hash, std::string_view content, SyntaxBlockWorkingMode working_mode, bool result, const std::set<Message>& messages);
+    void save();
+
+    size_t size() const;
+    size_t get_hits_count() const;
+
+    static inline constexpr char magic[4] = { 'Q', 'D', 'V', 'C' };
+    static inline constexpr uint32_t version = 2;
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t grammar_version;
+        uint32_t reserved;
+        uint64_t slots_count;           // степень двойки
+        uint64_t entries_count;
+        uint64_t messages_offset;
+        uint64_t messages_count;
+        uint64_t strings_offset;
+        uint64_t strings_size;
+    };
+
+    struct Slot {
+        uint64_t content_hash;
+        uint32_t content_length;
+        uint8_t working_mode;
+        uint8_t result;
+        uint8_t used;
+        uint8_t reserved;
+        uint32_t first_message;
+        uint32_t messages_count;
+        uint32_t content_offset;        // содержимое строки в области строк
+    };
+
+    struct MessageRecord {
+        int32_t token_index;
+        int16_t pool;
+        int16_t message;
+        uint32_t value_offset;
+        uint32_t value_length;
+    };
+
+    static_assert(sizeof(Header) == 64);
+    static_assert(sizeof(Slot) == 32);
+    static_assert(sizeof(MessageRecord) == 16);
+
+private:
+    struct Entry {
+        uint64_t content_hash;
+        uint32_t content_length;
+        SyntaxBlockWorkingMode working_mode;
+        bool result;
+        std::string content;
+        std::vector<MessageRecord> messages;
+        std::string values;
+    };
+
+    std::string file_path;
+    size_t max_entries;
+    std::unique_ptr<boost::interprocess::file_mapping> file_mapping;
+    std::unique_ptr<boost::interprocess::mapped_region> region;
+    const Header* header = nullptr;
+    const Slot* slots = nullptr;
+    const MessageRecord* message_records = nullptr;
+    const char* strings = nullptr;
+
+    std::vector<Entry> pending_entries;
+    mutable size_t hits_count = 0;
+    mutable omp_lock_t lock;
+
+    void open();
+    void close();
+    const Slot* find_slot(uint64_t content_hash, std::string_view content, SyntaxBlockWorkingMode working_mode) const;
+    std::vector<Entry> read_entries() const;
+};
\ No newline at end of file